@@ -0,0 +1,304 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "AudioPlayMidiFile.h"
+
+#define MIDI_DEFAULT_TEMPO 500000 // microseconds per quarter note, 120 bpm
+
+static uint32_t read_be(const uint8_t* p, int bytes) {
+	uint32_t value = 0;
+	for (int i = 0; i < bytes; ++i) value = value << 8 | p[i];
+	return value;
+}
+
+/**
+ * @brief Start playing a Standard MIDI File from its beginning. Anything
+ * already playing stops; notes it left sounding are the sink's to stop.
+ *
+ * @param source the file, which must stay valid while it plays
+ * @param sink what the file's events are sent to, from update()
+ * @return false if the file is not a type 0 or type 1 MIDI file
+ */
+bool AudioPlayMidiFile::play(MidiFileSource& source, MidiSink& sink) {
+	playing = false;
+	uint8_t header[14];
+	if (source.read(0, header, 14) != 14 || memcmp(header, "MThd", 4) != 0) return false;
+	uint32_t length = read_be(header + 4, 4);
+	uint16_t format = read_be(header + 8, 2);
+	uint16_t tracks_declared = read_be(header + 10, 2);
+	division = read_be(header + 12, 2);
+	if (length < 6 || format > 1 || division == 0) return false;
+
+	this->source = &source;
+	this->sink = &sink;
+	track_count = 0;
+	for (uint32_t offset = 8 + length; track_count < tracks_declared && track_count < MIDI_MAX_TRACKS;) {
+		uint8_t chunk[8];
+		if (source.read(offset, chunk, 8) != 8) break;
+		length = read_be(chunk + 4, 4);
+		if (memcmp(chunk, "MTrk", 4) == 0) {
+			track& t = tracks[track_count++];
+			t.offset = offset + 8;
+			t.end = offset + 8 + length;
+			t.tick = 0;
+			t.status = 0;
+			t.done = false;
+			t.cache_length = t.cache_pos = 0;
+			if (!readDelta(t)) t.done = true;
+		}
+		offset += 8 + length;
+	}
+	if (track_count == 0) return false;
+
+	tempo_tick = 0;
+	tempo_sample = 0;
+	setTempo(MIDI_DEFAULT_TEMPO);
+	block_start = 0;
+	playing = true;
+	return true;
+}
+
+/**
+ * @brief Stop playing. Notes that are sounding are left to the sink.
+ */
+void AudioPlayMidiFile::stop(void) {
+	playing = false;
+}
+
+/**
+ * @brief Set the length of a tick from a tempo, or from the file's SMPTE
+ * frame rate if it counts time in frames, from 'tempo_tick' on.
+ *
+ * @param micros_per_quarter the tempo, from a Set Tempo meta event
+ */
+void AudioPlayMidiFile::setTempo(uint32_t micros_per_quarter) {
+	double ticks_per_second;
+	if (division & 0x8000) {
+		// the high byte is minus the frames per second, the low byte ticks per frame
+		ticks_per_second = -(int8_t)(division >> 8) * (double)(division & 0xFF);
+	} else {
+		ticks_per_second = division * 1000000.0 / micros_per_quarter;
+	}
+	samples_per_tick = (uint64_t)(AUDIO_SAMPLE_RATE_EXACT * 4294967296.0 / ticks_per_second);
+}
+
+/**
+ * @brief Read the next byte of a track, refilling its cache from the source
+ * when it runs out.
+ *
+ * @return false at the end of the track
+ */
+bool AudioPlayMidiFile::readByte(track& t, uint8_t& value) {
+	if (t.cache_pos == t.cache_length) {
+		uint32_t length = t.end - t.offset;
+		if (length > MIDI_TRACK_CACHE) length = MIDI_TRACK_CACHE;
+		if (length == 0) return false;
+		length = source->read(t.offset, t.cache, length);
+		if (length == 0) return false;
+		t.offset += length;
+		t.cache_length = length;
+		t.cache_pos = 0;
+	}
+	value = t.cache[t.cache_pos++];
+	return true;
+}
+
+/**
+ * @brief Read a variable-length quantity from a track: 7 bits per byte,
+ * most significant first, the top bit set on all but the last byte.
+ *
+ * @return false at the end of the track
+ */
+bool AudioPlayMidiFile::readNumber(track& t, uint32_t& value) {
+	value = 0;
+	for (int i = 0; i < 4; ++i) {
+		uint8_t byte;
+		if (!readByte(t, byte)) return false;
+		value = value << 7 | (byte & 0x7F);
+		if ((byte & 0x80) == 0) return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Skip 'length' bytes of a track, reading past the cache only when
+ * they run beyond it.
+ */
+void AudioPlayMidiFile::skip(track& t, uint32_t length) {
+	uint32_t cached = t.cache_length - t.cache_pos;
+	if (length <= cached) {
+		t.cache_pos += length;
+		return;
+	}
+	length -= cached;
+	t.offset = length < t.end - t.offset ? t.offset + length : t.end;
+	t.cache_length = t.cache_pos = 0;
+}
+
+/**
+ * @brief Read the delta time in front of a track's next event and advance
+ * the track's tick by it.
+ *
+ * @return false at the end of the track
+ */
+bool AudioPlayMidiFile::readDelta(track& t) {
+	uint32_t delta;
+	if (!readNumber(t, delta)) return false;
+	t.tick += delta;
+	return true;
+}
+
+/**
+ * @brief Read a track's next event, send it to the sink, and read the delta
+ * time of the one after it.
+ *
+ * @param t the track, whose next event is due
+ * @param offset the sample within the current block the event falls on
+ */
+void AudioPlayMidiFile::dispatch(track& t, int offset) {
+	uint8_t status;
+	if (!readByte(t, status)) {
+		t.done = true;
+		return;
+	}
+	// running status: the byte is the first data byte of a repeated status
+	const uint8_t first = status;
+	const bool running = status < 0x80;
+	if (running) {
+		status = t.status;
+		if (status == 0) {
+			t.done = true;
+			return;
+		}
+	}
+
+	if (status == 0xFF) {
+		// meta event: type, length, data
+		uint8_t type;
+		uint32_t length;
+		t.status = 0;
+		if (!readByte(t, type) || !readNumber(t, length) || type == 0x2F) {
+			t.done = true;
+			return;
+		}
+		if (type == 0x51 && length == 3) {
+			uint8_t tempo[3];
+			if (!readByte(t, tempo[0]) || !readByte(t, tempo[1]) || !readByte(t, tempo[2])) {
+				t.done = true;
+				return;
+			}
+			// every track shares the tempo, which changes from this tick on
+			tempo_sample += (uint64_t)(t.tick - tempo_tick) * samples_per_tick;
+			tempo_tick = t.tick;
+			setTempo(read_be(tempo, 3));
+		} else {
+			skip(t, length);
+		}
+	} else if (status == 0xF0 || status == 0xF7) {
+		// system exclusive: length, data
+		uint32_t length;
+		t.status = 0;
+		if (!readNumber(t, length)) {
+			t.done = true;
+			return;
+		}
+		skip(t, length);
+	} else if (status >= 0xF0) {
+		// not allowed in a file; nothing after it can be parsed
+		t.done = true;
+		return;
+	} else {
+		uint8_t kind = status & 0xF0, channel = status & 0x0F;
+		uint8_t data1 = first, data2 = 0;
+		if (!running) {
+			t.status = status;
+			if (!readByte(t, data1)) {
+				t.done = true;
+				return;
+			}
+		}
+		if (kind != 0xC0 && kind != 0xD0 && !readByte(t, data2)) {
+			t.done = true;
+			return;
+		}
+		// data bytes are 7-bit; a malformed file must not pass on more
+		data1 &= 0x7F;
+		data2 &= 0x7F;
+		switch (kind) {
+		case 0x80:
+			sink->noteOff(channel, data1, offset);
+			break;
+		case 0x90:
+			// a note-on with no velocity is a note-off
+			if (data2 == 0) sink->noteOff(channel, data1, offset);
+			else sink->noteOn(channel, data1, data2, offset);
+			break;
+		case 0xB0:
+			sink->controlChange(channel, data1, data2);
+			break;
+		case 0xC0:
+			sink->programChange(channel, data1);
+			break;
+		default:
+			// aftertouch, channel pressure and pitch bend are not played
+			break;
+		}
+	}
+	if (!readDelta(t)) t.done = true;
+}
+
+/**
+ * @brief Dispatch the events that fall within the next audio block, in
+ * order of time (and of track, at equal times), then move on a block.
+ * Called from update(); a host can call it directly to play a file
+ * without running the audio update list.
+ *
+ * @return false once every track has ended
+ */
+bool AudioPlayMidiFile::playBlock(void) {
+	if (!playing) return false;
+	const uint64_t block_end = (uint64_t)(block_start + AUDIO_BLOCK_SAMPLES) << 32;
+	for (;;) {
+		track* next = NULL;
+		for (int i = 0; i < track_count; ++i) {
+			if (!tracks[i].done && (next == NULL || tracks[i].tick < next->tick)) next = &tracks[i];
+		}
+		if (next == NULL) {
+			playing = false;
+			break;
+		}
+		uint64_t when = tempo_sample + (uint64_t)(next->tick - tempo_tick) * samples_per_tick;
+		if (when >= block_end) break;
+		int offset = (int)((when >> 32) - block_start);
+		dispatch(*next, offset < 0 ? 0 : offset);
+	}
+	block_start += AUDIO_BLOCK_SAMPLES;
+	return playing;
+}
+
+void AudioPlayMidiFile::update(void) {
+	playBlock();
+}
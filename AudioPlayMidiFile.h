@@ -0,0 +1,217 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+#include "AudioStream.h"
+#include "AudioSynthWavetablePoly.h"
+#include "WavetableVoiceManager.h"
+#include <stdint.h>
+
+#define MIDI_MAX_TRACKS 16 // tracks of a type 1 file played together
+#define MIDI_TRACK_CACHE 16 // bytes of each track read from the source at a time
+#define MIDI_CHANNELS 16
+
+/**
+ * @brief Where a Standard MIDI File is read from: random access by offset,
+ * so every track can be streamed at its own position without buffering the
+ * file.
+ */
+class MidiFileSource
+{
+public:
+	virtual ~MidiFileSource(void) {}
+
+	/**
+	 * @brief Read up to 'length' bytes from 'offset'.
+	 *
+	 * @return the bytes read, fewer at the end of the file
+	 */
+	virtual uint32_t read(uint32_t offset, uint8_t* data, uint32_t length) = 0;
+};
+
+// A file already in memory (or flash).
+class MidiMemorySource : public MidiFileSource
+{
+public:
+	MidiMemorySource(const uint8_t* data, uint32_t size) : data(data), size(size) {}
+	virtual uint32_t read(uint32_t offset, uint8_t* out, uint32_t length) {
+		if (offset >= size) return 0;
+		if (length > size - offset) length = size - offset;
+		memcpy(out, data + offset, length);
+		return length;
+	}
+private:
+	const uint8_t* data;
+	uint32_t size;
+};
+
+#ifdef HOST_BUILD
+// A file on disk, read through stdio.
+class MidiStdioSource : public MidiFileSource
+{
+public:
+	explicit MidiStdioSource(FILE* file) : file(file) {}
+	virtual uint32_t read(uint32_t offset, uint8_t* out, uint32_t length) {
+		if (fseek(file, offset, SEEK_SET) != 0) return 0;
+		return fread(out, 1, length, file);
+	}
+private:
+	FILE* file;
+};
+#endif
+
+/**
+ * @brief What a MIDI file player drives. 'offset' is the sample within the
+ * current audio block at which the event falls, 0 to AUDIO_BLOCK_SAMPLES-1.
+ */
+class MidiSink
+{
+public:
+	virtual ~MidiSink(void) {}
+	virtual void noteOn(uint8_t channel, uint8_t note, uint8_t velocity, int offset) = 0;
+	virtual void noteOff(uint8_t channel, uint8_t note, int offset) = 0;
+	virtual void programChange(uint8_t channel, uint8_t program) { (void)channel; (void)program; }
+	virtual void controlChange(uint8_t channel, uint8_t control, uint8_t value) {
+		(void)channel; (void)control; (void)value;
+	}
+};
+
+/**
+ * @brief Plays a Standard MIDI File (type 0 or 1) into a MidiSink, from the
+ * audio interrupt.
+ *
+ * As an AudioStream object with no inputs or outputs, the player's update()
+ * runs once per audio block: it dispatches every event that falls within
+ * the block, with its sample offset, so timing never depends on loop().
+ * Construct it before the voices it drives, so they hear its events in the
+ * same block. Tracks are streamed from the source a few bytes at a time and
+ * nothing is allocated, before or during playback.
+ */
+class AudioPlayMidiFile : public AudioStream
+{
+public:
+	AudioPlayMidiFile(void) : AudioStream(0, NULL) { active = true; }
+
+	// Defined in AudioPlayMidiFile.cpp
+	bool play(MidiFileSource& source, MidiSink& sink);
+	void stop(void);
+	bool playBlock(void);
+	virtual void update(void);
+
+	bool isPlaying(void) { return playing; }
+
+	/**
+	 * @brief The position of the next block to play, in samples from the
+	 * start of the song.
+	 */
+	uint32_t positionSamples(void) { return block_start; }
+
+private:
+	struct track {
+		uint32_t offset; // next byte of the track in the file
+		uint32_t end;    // end of the track's chunk
+		uint32_t tick;   // absolute time of the next event, in ticks
+		uint8_t status;  // running status
+		bool done;
+		uint8_t cache_length, cache_pos;
+		uint8_t cache[MIDI_TRACK_CACHE];
+	};
+
+	bool readByte(track& t, uint8_t& value);
+	bool readNumber(track& t, uint32_t& value);
+	void skip(track& t, uint32_t length);
+	bool readDelta(track& t);
+	void dispatch(track& t, int offset);
+	void setTempo(uint32_t micros_per_quarter);
+
+	volatile bool playing = false;
+	MidiFileSource* source = NULL;
+	MidiSink* sink = NULL;
+	track tracks[MIDI_MAX_TRACKS];
+	int track_count = 0;
+
+	// the time of tick 'tempo_tick', and samples per tick, both in Q32.32
+	// samples, so tempo changes never accumulate rounding
+	uint16_t division = 0;
+	uint32_t tempo_tick = 0;
+	uint64_t tempo_sample = 0;
+	uint64_t samples_per_tick = 0;
+	uint32_t block_start = 0;
+};
+
+/**
+ * @brief Plays MIDI events on the voices of an AudioSynthWavetablePoly,
+ * through a WavetableVoiceManager: each note-on takes a free voice (or one
+ * taken from another note) and plays the instrument set for its channel;
+ * each note-off releases the voice playing that channel and note. Both take
+ * effect on the sample the event falls on.
+ */
+template <int N>
+class WavetableMidiSink : public MidiSink
+{
+public:
+	/**
+	 * @brief Play MIDI events on the first 'count' voices of a pool.
+	 *
+	 * @param voices the pool
+	 * @param count a value between 1 and N
+	 */
+	WavetableMidiSink(AudioSynthWavetablePoly<N>& voices, int count = N) : manager(&voices[0], count) {}
+
+	/**
+	 * @brief Set the instrument a channel plays; channels without one are
+	 * ignored.
+	 *
+	 * @param channel 0 to 15
+	 * @param instrument the instrument, or NULL to mute the channel
+	 */
+	void setInstrument(uint8_t channel, const instrument_data* instrument) {
+		manager.setInstrument(channel, instrument);
+	}
+
+	/**
+	 * @brief The voice manager, to set its steal policy and channel priorities.
+	 */
+	WavetableVoiceManager<N>& voices(void) { return manager; }
+
+	virtual void noteOn(uint8_t channel, uint8_t note, uint8_t velocity, int offset) {
+		manager.noteOn(channel, note, velocity, offset);
+	}
+
+	virtual void noteOff(uint8_t channel, uint8_t note, int offset) {
+		manager.noteOff(channel, note, offset);
+	}
+
+	/**
+	 * @brief Release every voice, e.g. after stopping the player mid-song.
+	 */
+	void allNotesOff(void) { manager.allNotesOff(); }
+
+private:
+	WavetableVoiceManager<N> manager;
+};
@@ -0,0 +1,128 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "AudioPlayScore.h"
+
+/**
+ * @brief Start playing a compiled score from its beginning.
+ *
+ * @param events the score's events, in order of sample; they must stay
+ * valid while it plays
+ * @param count the number of events
+ * @param voices the voices the score was compiled for, e.g. &pool[0] for an
+ * AudioSynthWavetablePoly
+ * @param voice_count the number of voices, at least as many as the score uses
+ * @param instruments the instrument for each slot of the score
+ * @param instrument_count the number of slots, at least as many as the score
+ * uses
+ * @return false if an event names a voice or slot that was not given
+ */
+bool AudioPlayScore::play(const wavetable_score_event* events, uint32_t count, AudioSynthWavetable* voices,
+	int voice_count, const instrument_data* const* instruments, int instrument_count)
+{
+	playing = false;
+	// checked once here, so dispatch need not
+	for (uint32_t i = 0; i < count; ++i) {
+		if (events[i].type != SCORE_END && events[i].voice >= voice_count) return false;
+		if (events[i].type == SCORE_INSTRUMENT && events[i].data1 >= instrument_count) return false;
+		if (events[i].type > SCORE_END || (i > 0 && events[i].sample < events[i - 1].sample)) return false;
+	}
+	this->events = events;
+	this->count = count;
+	this->voices = voices;
+	this->instruments = instruments;
+	next = 0;
+	block_start = 0;
+	playing = true;
+	return true;
+}
+
+/**
+ * @brief Start playing a compiled score file (a wavetable_score_header and
+ * its events) from its beginning.
+ *
+ * @param score the file's contents, 4-byte aligned
+ * @param size the file's size in bytes
+ * @return false if it is not a compiled score, or see above
+ */
+bool AudioPlayScore::play(const void* score, uint32_t size, AudioSynthWavetable* voices, int voice_count,
+	const instrument_data* const* instruments, int instrument_count)
+{
+	const wavetable_score_header* header = (const wavetable_score_header*)score;
+	if (size < sizeof(wavetable_score_header) || header->magic != SCORE_MAGIC || header->version != SCORE_VERSION
+		|| (size - sizeof(wavetable_score_header)) / sizeof(wavetable_score_event) < header->event_count
+		|| header->voices > voice_count || header->instruments > instrument_count) {
+		playing = false;
+		return false;
+	}
+	return play((const wavetable_score_event*)(header + 1), header->event_count, voices, voice_count,
+		instruments, instrument_count);
+}
+
+/**
+ * @brief Stop playing. Notes that are sounding are left to play out.
+ */
+void AudioPlayScore::stop(void) {
+	playing = false;
+}
+
+/**
+ * @brief Dispatch the events that fall within the next audio block, then
+ * move on a block. Called from update(); a host can call it directly to
+ * play a score without running the audio update list.
+ *
+ * @return false once the score has ended
+ */
+bool AudioPlayScore::playBlock(void) {
+	if (!playing) return false;
+	const uint32_t block_end = block_start + AUDIO_BLOCK_SAMPLES;
+	for (; next < count && events[next].sample < block_end; ++next) {
+		const wavetable_score_event& e = events[next];
+		if (e.type == SCORE_END) {
+			next = count;
+			break;
+		}
+		switch (e.type) {
+		case SCORE_NOTE:
+			voices[e.voice].stealNote(e.data1, e.data2, e.sample - block_start);
+			break;
+		case SCORE_STOP:
+			voices[e.voice].stop(e.sample - block_start);
+			break;
+		default:
+			// the note still sounding fades out under the next one
+			voices[e.voice].setInstrument(*instruments[e.data1], false);
+			break;
+		}
+	}
+	if (next == count) playing = false;
+	block_start = block_end;
+	return playing;
+}
+
+void AudioPlayScore::update(void) {
+	playBlock();
+}
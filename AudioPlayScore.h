@@ -0,0 +1,105 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+#include "AudioStream.h"
+#include "AudioSynthWavetable.h"
+#include <stdint.h>
+
+#define SCORE_MAGIC 0x43535457 // "WTSC", little-endian
+#define SCORE_VERSION 1
+
+enum scoreEventEnum { SCORE_NOTE, SCORE_STOP, SCORE_INSTRUMENT, SCORE_END };
+
+/**
+ * @brief One event of a compiled score: what a voice does at which sample.
+ * Voices and instruments were assigned when the score was compiled (see
+ * host/score_compiler.h), so playing it takes no decisions.
+ */
+struct wavetable_score_event {
+	uint32_t sample;  // from the start of the score
+	uint8_t type;     // scoreEventEnum
+	uint8_t voice;
+	uint8_t data1;    // SCORE_NOTE: note; SCORE_INSTRUMENT: instrument slot
+	uint8_t data2;    // SCORE_NOTE: velocity
+};
+
+/**
+ * @brief The start of a compiled score file, followed by 'event_count'
+ * events. Both are little-endian, as on the Teensy and x86 hosts, so a
+ * score in memory can be played where it lies.
+ */
+struct wavetable_score_header {
+	uint32_t magic;        // SCORE_MAGIC
+	uint16_t version;      // SCORE_VERSION
+	uint16_t voices;       // voices the score uses
+	uint16_t instruments;  // instrument slots it uses
+	uint16_t reserved;
+	uint32_t event_count;
+};
+
+/**
+ * @brief Plays a compiled score on a set of voices, from the audio
+ * interrupt.
+ *
+ * Each update() dispatches the events whose sample falls within the block
+ * about to be rendered: one comparison per event, and a call on the voice it
+ * names. Construct the player before the voices, so they hear its events in
+ * the same block.
+ */
+class AudioPlayScore : public AudioStream
+{
+public:
+	AudioPlayScore(void) : AudioStream(0, NULL) { active = true; }
+
+	// Defined in AudioPlayScore.cpp
+	bool play(const wavetable_score_event* events, uint32_t count, AudioSynthWavetable* voices, int voice_count,
+		const instrument_data* const* instruments, int instrument_count);
+	bool play(const void* score, uint32_t size, AudioSynthWavetable* voices, int voice_count,
+		const instrument_data* const* instruments, int instrument_count);
+	void stop(void);
+	bool playBlock(void);
+	virtual void update(void);
+
+	bool isPlaying(void) { return playing; }
+
+	/**
+	 * @brief The position of the next block to play, in samples from the
+	 * start of the score.
+	 */
+	uint32_t positionSamples(void) { return block_start; }
+
+private:
+	volatile bool playing = false;
+	const wavetable_score_event* events = NULL;
+	uint32_t count = 0;
+	uint32_t next = 0;
+	uint32_t block_start = 0;
+	AudioSynthWavetable* voices = NULL;
+	const instrument_data* const* instruments = NULL;
+};
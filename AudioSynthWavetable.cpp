@@ -27,8 +27,12 @@
 #include "AudioSynthWavetable.h"
 #include <dspinst.h>
 #include <SerialFlash.h>
+#include <string.h>
 
+#ifndef HOST_BUILD
+// prints render timing over Serial; host builds time with wavetable_bench
 #define TIME_TEST_ON
+#endif
 #define ENVELOPE_DEBUG
 
 #ifdef TIME_TEST_ON
@@ -62,21 +66,121 @@ CODE_BLOCK_TO_TEST
 #endif
 
 
+#define EQUAL_TEMPERAMENT_4(N) AudioSynthWavetable::equalTemperedFrequency(N), AudioSynthWavetable::equalTemperedFrequency(N + 1), \
+	AudioSynthWavetable::equalTemperedFrequency(N + 2), AudioSynthWavetable::equalTemperedFrequency(N + 3)
+#define EQUAL_TEMPERAMENT_16(N) EQUAL_TEMPERAMENT_4(N), EQUAL_TEMPERAMENT_4(N + 4), EQUAL_TEMPERAMENT_4(N + 8), EQUAL_TEMPERAMENT_4(N + 12)
+#define EQUAL_TEMPERAMENT_64(N) EQUAL_TEMPERAMENT_16(N), EQUAL_TEMPERAMENT_16(N + 16), EQUAL_TEMPERAMENT_16(N + 32), EQUAL_TEMPERAMENT_16(N + 48)
+
+const uint32_t AudioSynthWavetable::equal_temperament[NOTE_COUNT] = { EQUAL_TEMPERAMENT_64(0), EQUAL_TEMPERAMENT_64(64) };
+
+static_assert(AudioSynthWavetable::equalTemperedFrequency(69) == 440u << TUNING_FRACTION_BITS, "A4 must be 440 Hz");
+static_assert(AudioSynthWavetable::equalTemperedFrequency(127) < UINT32_MAX >> 2, "note frequencies must fit Q16.16");
+
+/**
+ * @brief Fill a tuning table for setTuning() from a scale's deviation from
+ * equal temperament, as in a MIDI Tuning Standard scale/octave tuning.
+ *
+ * Uses double precision, to keep every note within Q16.16 rounding of the
+ * exact frequency; build tables ahead of time, not at note-on.
+ * @param frequencies NOTE_COUNT entries to fill
+ * @param cents 12 offsets in cents, for C, C#, ... B
+ * @param reference the frequency of A4 before its offset is applied
+ */
+void AudioSynthWavetable::tuningTable(uint32_t* frequencies, const float* cents, float reference) {
+	for (int note = 0; note < NOTE_COUNT; ++note) {
+		double freq = reference * pow(2.0, ((note - 69) * 100 + cents[note % 12]) / 1200.0);
+		freq *= 1 << TUNING_FRACTION_BITS;
+		frequencies[note] = freq <= 0.0 ? 0 : freq >= UINT32_MAX ? UINT32_MAX : (uint32_t)(freq + 0.5);
+	}
+}
+
+// Note tables built for instruments decoded without one, shared by every
+// voice playing them. Instruments beyond these fall back to scanning.
+// Any context may fill a slot: it claims the slot first, and publishes the
+// table only once it is built.
+#define NOTE_TABLE_CACHE_SIZE 8
+
+static struct {
+	std::atomic<const instrument_data*> claimed;    // the instrument filling the slot
+	std::atomic<const instrument_data*> instrument; // set once note_samples is built
+	uint8_t note_samples[NOTE_COUNT];
+} note_table_cache[NOTE_TABLE_CACHE_SIZE];
+
+/**
+ * @brief Find the sample that plays 'note' by scanning the instrument's
+ * note ranges, never past the last sample.
+ *
+ * @param instrument the instrument to search
+ * @param note a MIDI note number, 0 to 127
+ * @return an index into the instrument's samples
+ */
+int AudioSynthWavetable::scanNoteRanges(const instrument_data& instrument, int note) {
+	int i;
+	for (i = 0; i < instrument.sample_count - 1 && note > instrument.sample_note_ranges[i]; i++);
+	return i;
+}
+
+/**
+ * @brief Get the zone map of an instrument.
+ * Decoder output carries one; for older data a note-to-sample table (with
+ * a single velocity band) is built on first use.
+ *
+ * @param instrument the instrument to look up
+ * @return the zone map, or NULL if the table cache is full or the table
+ * is still being built
+ */
+const uint8_t* AudioSynthWavetable::noteSamples(const instrument_data& instrument) {
+	if (instrument.note_samples) return instrument.note_samples;
+	for (int c = 0; c < NOTE_TABLE_CACHE_SIZE; ++c) {
+		if (note_table_cache[c].instrument.load(std::memory_order_acquire) == &instrument)
+			return note_table_cache[c].note_samples;
+		const instrument_data* claimed = NULL;
+		if (!note_table_cache[c].claimed.compare_exchange_strong(claimed, &instrument,
+			std::memory_order_relaxed)) {
+			// being built by a context this one may have interrupted, so
+			// scan rather than wait for it
+			if (claimed == &instrument) return NULL;
+			continue;
+		}
+		for (int note = 0; note < NOTE_COUNT; ++note)
+			note_table_cache[c].note_samples[note] = scanNoteRanges(instrument, note);
+		note_table_cache[c].instrument.store(&instrument, std::memory_order_release);
+		return note_table_cache[c].note_samples;
+	}
+	return NULL;
+}
+
 /**
  * @brief Stop playing waveform.
  *
  * Waveform does not immediately stop,
- * but fades out based on release time.
+ * but fades out based on release time, from the next block.
  *
  */
 void AudioSynthWavetable::stop(void) {
-	cli();
-	env_state = STATE_RELEASE;
-	env_count = current_sample->RELEASE_COUNT;
-	if (env_count == 0) env_count = 1;
-	env_incr = -(env_mult) / (env_count * ENVELOPE_PERIOD);
-	PRINT_ENV(STATE_RELEASE)
-	sei();
+	stop(0);
+}
+
+/**
+ * @brief Stop playing waveform from a given sample of the next block.
+ *
+ * @param offset the sample of the next block the release starts on, between
+ * 0 and AUDIO_BLOCK_SAMPLES-1
+ */
+void AudioSynthWavetable::stop(int offset) {
+	post(makeEvent(EVENT_STOP, offset));
+}
+
+/**
+ * @brief Silence the note playing with a linear ramp over QUICK_KILL_PERIODS
+ * envelope periods, from wherever its envelope is, rather than through its
+ * release; e.g. to shed voices when the synth is overloaded.
+ *
+ * @param offset the sample of the next block the ramp starts on, between 0
+ * and AUDIO_BLOCK_SAMPLES-1
+ */
+void AudioSynthWavetable::quickKill(int offset) {
+	post(makeEvent(EVENT_KILL, offset));
 }
 
 /**
@@ -86,7 +190,20 @@ void AudioSynthWavetable::stop(void) {
  * @param amp the amplitude level at which playback should occur
  */
 void AudioSynthWavetable::playFrequency(float freq, int amp) {
-	setState(freqToNote(freq), amp, freq);
+	postNote(freqToNote(freq), amp, freq * (1 << TUNING_FRACTION_BITS), 0, EVENT_NOTE);
+}
+
+/**
+ * @brief Play waveform at defined frequency, amplitude, from a given sample
+ * of the next block.
+ *
+ * @param freq freqency of the generated output (between 0 and the board-specific sample rate)
+ * @param amp the amplitude level at which playback should occur
+ * @param offset the sample of the next block the note starts on, between 0
+ * and AUDIO_BLOCK_SAMPLES-1; the voice plays on (or stays silent) until then
+ */
+void AudioSynthWavetable::playFrequency(float freq, int amp, int offset) {
+	postNote(freqToNote(freq), amp, freq * (1 << TUNING_FRACTION_BITS), offset, EVENT_NOTE);
 }
 
 /**
@@ -97,242 +214,662 @@ void AudioSynthWavetable::playFrequency(float freq, int amp) {
  */
 void AudioSynthWavetable::playNote(int note, int amp) {
 	Serial.printf("note=%d\n", note);
-	setState(note, amp, noteToFreq(note));
+	postNote(note, amp, tuning.load(std::memory_order_acquire)[note < 0 ? 0 : note >= NOTE_COUNT ? NOTE_COUNT - 1 : note], 0, EVENT_NOTE);
+}
+
+/**
+ * @brief Play sample at specified note, amplitude, from a given sample of
+ * the next block, e.g. the offset of a MIDI event within the block.
+ *
+ * @param note the midi note number (a value between 0 and 127)
+ * @param amp amplitude of generated output
+ * @param offset the sample of the next block the note starts on, between 0
+ * and AUDIO_BLOCK_SAMPLES-1; the voice plays on (or stays silent) until then
+ */
+void AudioSynthWavetable::playNote(int note, int amp, int offset) {
+	postNote(note, amp, tuning.load(std::memory_order_acquire)[note < 0 ? 0 : note >= NOTE_COUNT ? NOTE_COUNT - 1 : note], offset, EVENT_NOTE);
+}
+
+/**
+ * @brief Play a note in place of whatever the voice is playing, as when a
+ * voice allocator steals it: rather than being cut off mid-waveform, the
+ * old note fades out over QUICK_KILL_PERIODS envelope periods, mixed under
+ * the new one, which starts on time. On an idle voice it is playNote().
+ * A note already fading out is cut off by the next one stolen.
+ *
+ * @param note the midi note number (a value between 0 and 127)
+ * @param amp amplitude of generated output
+ * @param offset the sample of the next block the note starts on, between 0
+ * and AUDIO_BLOCK_SAMPLES-1
+ */
+void AudioSynthWavetable::stealNote(int note, int amp, int offset) {
+	postNote(note, amp, tuning.load(std::memory_order_acquire)[note < 0 ? 0 : note >= NOTE_COUNT ? NOTE_COUNT - 1 : note], offset, EVENT_STEAL);
+}
+
+/**
+ * @brief Queue an event for render() to apply at the start of the next block.
+ *
+ * @param event the event
+ * @return false if the queue was full and the event was dropped
+ */
+bool AudioSynthWavetable::post(const wavetable_event& event) {
+	if (!events.push(event)) {
+		dropped_events.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	// wake a voice parked by update(); pairs with the fence in park()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (streamed.load(std::memory_order_relaxed)) active = true;
+	return true;
 }
 
 /**
- * @brief Set various state information for the wavetable object before playing.
- * Selects the sample from within the instrument_data struct to be played.
+ * @brief Work out a note's spec and queue it to start in the next block.
  *
  * @param note the note that the wavetable object should play
  * @param amp the amplitude level at which playback should occur
- * @param freq exact frequency of the note to be played played
+ * @param frequency exact frequency of the note to be played, in Hz as unsigned Q16.16
+ * @param offset the sample of the next block the note starts on
+ * @param type EVENT_NOTE, or EVENT_STEAL to fade out the note it replaces
  */
-void AudioSynthWavetable::setState(int note, int amp, float freq) {
-	cli();
-	int i;
-	env_state = STATE_IDLE;
-	for (i = 0; note > instrument->sample_note_ranges[i]; i++);
-	current_sample = &instrument->samples[i];
-	if (current_sample == NULL) return;
-	setFrequency(freq);
-	vib_count = mod_count = tone_phase = env_incr = env_mult = 0;
-	vib_phase = mod_phase = TRIANGLE_INITIAL_PHASE;
-	env_count = current_sample->DELAY_COUNT;
-	tone_amp = amp * (UINT16_MAX / 127);
-	tone_amp = current_sample->INITIAL_ATTENUATION_SCALAR * tone_amp >> 16;
+void AudioSynthWavetable::postNote(int note, int amp, uint32_t frequency, int offset, wavetableEventEnum type) {
+	const instrument_data* instrument = this->instrument.load(std::memory_order_acquire);
+	if (instrument == NULL) return;
+	amp = amp < 0 ? 0 : amp > 127 ? 127 : amp;
+	wavetable_event event = makeEvent(type, offset);
+	noteSpec(event.note, &instrument->samples[sampleIndex(*instrument, note, amp)], amp, frequency);
+	// counted before it is posted, so isPlaying() never misses it
+	pending_notes.fetch_add(1, std::memory_order_relaxed);
+	if (!post(event)) pending_notes.fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief Start the envelope of a new note, in its delay.
+ *
+ * @param s the sample being played, which holds the stage lengths
+ * @param env_state,env_count,env_mult,env_incr the envelope, set in place
+ */
+static void envelope_start(const sample_data* s, envelopeStateEnum& env_state, int32_t& env_count,
+	int32_t& env_mult, int32_t& env_incr) {
+	env_incr = env_mult = 0;
+	env_count = s->DELAY_COUNT;
 	env_state = STATE_DELAY;
 	PRINT_ENV(STATE_DELAY);
-	state_change = true;
-	sei();
 }
 
 /**
- * @brief Change the frequency of the waveform to the defined freq.
+ * @brief Start the release of the envelope, from wherever it is now.
  *
- * @param freq frequency of the generated output (between 0 and the board-specific sample rate)
+ * @param s the sample being played, which holds the stage lengths
+ * @param env_state,env_count,env_mult,env_incr the envelope, updated in place
  */
-void AudioSynthWavetable::setFrequency(float freq) {
-	float tone_incr_temp = freq * current_sample->PER_HERTZ_PHASE_INCREMENT;
-	tone_incr = tone_incr_temp;
-	vib_pitch_offset_init = tone_incr_temp * current_sample->VIBRATO_PITCH_COEFFICIENT_INITIAL;
-	vib_pitch_offset_scnd = tone_incr_temp * current_sample->VIBRATO_PITCH_COEFFICIENT_SECOND;
-	mod_pitch_offset_init = tone_incr_temp * current_sample->MODULATION_PITCH_COEFFICIENT_INITIAL;
-	mod_pitch_offset_scnd = tone_incr_temp * current_sample->MODULATION_PITCH_COEFFICIENT_SECOND;
+static void envelope_release(const sample_data* s, envelopeStateEnum& env_state, int32_t& env_count,
+	int32_t& env_mult, int32_t& env_incr) {
+	env_state = STATE_RELEASE;
+	env_count = s->RELEASE_COUNT;
+	if (env_count == 0) env_count = 1;
+	env_incr = -(env_mult) / (env_count * ENVELOPE_PERIOD);
+	PRINT_ENV(STATE_RELEASE)
 }
 
 /**
- * @brief Called by the AudioStream library to fill the audio output buffer.
- * Performs interpolation and enveloping of output audio values.
+ * @brief Ramp the envelope linearly down to silence over QUICK_KILL_PERIODS,
+ * whatever stage it is in, for a stolen note.
  *
+ * @param v the voice's state, its envelope updated in place
  */
-void AudioSynthWavetable::update(void) {
-	cli();
-	if (env_state == STATE_IDLE) {
-		sei();
-		return;
+static void envelope_quick_kill(wavetable_voice_state& v) {
+	v.env_state = STATE_RELEASE;
+	v.env_count = QUICK_KILL_PERIODS;
+	v.env_incr = -v.env_mult / (QUICK_KILL_PERIODS * ENVELOPE_PERIOD);
+}
+
+/**
+ * @brief Apply the posted events that are due by 'position' in the block,
+ * in order. An event due later is held back until render() reaches it.
+ * Called by render() and update() only, so nothing else changes the
+ * playback state.
+ *
+ * @param position the sample of the block rendered up to
+ * @return the offset of the next event held back, or AUDIO_BLOCK_SAMPLES
+ */
+int AudioSynthWavetable::applyEvents(int position) {
+	if (deferred_pending) {
+		if (deferred.offset > position) return deferred.offset;
+		applyEvent(deferred);
+		deferred_pending = false;
 	}
-	this->state_change = false;
+	while (events.pop(deferred)) {
+		if (deferred.offset > position) {
+			deferred_pending = true;
+			publish();
+			return deferred.offset;
+		}
+		applyEvent(deferred);
+	}
+	publish();
+	return AUDIO_BLOCK_SAMPLES;
+}
 
-	const sample_data* s = (const sample_data*)current_sample;
-	uint32_t tone_phase = this->tone_phase;
-	uint32_t tone_incr = this->tone_incr;
-	uint16_t tone_amp = this->tone_amp;
+/**
+ * @brief Publish the envelope stage for isPlaying() and getEnvState(), and
+ * tell the idle listener, if any, when a voice that was sounding (or had a
+ * note start since) has gone idle.
+ */
+void AudioSynthWavetable::publish(void) {
+	bool idle = state.env_state == STATE_IDLE;
+	published_state.store(state.env_state, std::memory_order_release);
+	if (sounding && idle && idle_listener != NULL) idle_listener->voiceIdle(idle_id);
+	sounding = !idle;
+}
 
-	envelopeStateEnum  env_state = this->env_state;
-	int32_t env_count = this->env_count;
-	int32_t env_mult = this->env_mult;
-	int32_t env_incr = this->env_incr;
+/**
+ * @brief Apply one event to the playback state.
+ */
+void AudioSynthWavetable::applyEvent(const wavetable_event& event) {
+	wavetable_voice_state& v = state;
+	switch (event.type) {
+	case EVENT_NOTE:
+		startNote(event.note);
+		break;
+	case EVENT_STEAL:
+		// the note sounding fades out from here, under the new one
+		if (v.env_state != STATE_IDLE) {
+			fade = v;
+			envelope_quick_kill(fade);
+			fading = true;
+		}
+		startNote(event.note);
+		break;
+	case EVENT_STOP:
+		if (v.env_state != STATE_IDLE) envelope_release(v.note.sample, v.env_state, v.env_count, v.env_mult, v.env_incr);
+		break;
+	case EVENT_KILL:
+		if (v.env_state != STATE_IDLE) envelope_quick_kill(v);
+		break;
+	case EVENT_SILENCE:
+		v.env_state = STATE_IDLE;
+		fading = false;
+		break;
+	case EVENT_AMPLITUDE:
+		v.tone_amp = event.amplitude;
+		break;
+	}
+}
 
-	uint32_t vib_count = this->vib_count;
-	uint32_t vib_phase = this->vib_phase;
-	int32_t vib_pitch_offset_init = this->vib_pitch_offset_init;
-	int32_t vib_pitch_offset_scnd = this->vib_pitch_offset_scnd;
+/**
+ * @brief Start a note from the beginning of its sample and envelope.
+ */
+void AudioSynthWavetable::startNote(const wavetable_note_spec& note) {
+	wavetable_voice_state& v = state;
+	v.note = note;
+	v.tone_amp = note.tone_amp;
+	v.tone_phase = 0;
+	v.vib_count = v.mod_count = 0;
+	v.vib_phase = v.mod_phase = TRIANGLE_INITIAL_PHASE;
+	envelope_start(v.note.sample, v.env_state, v.env_count, v.env_mult, v.env_incr);
+	pending_notes.fetch_sub(1, std::memory_order_release);
+	sounding = true;
+}
 
-	uint32_t mod_count = this->mod_count;
-	int32_t mod_phase = this->mod_phase;
-	int32_t mod_pitch_offset_init = this->mod_pitch_offset_init;
-	int32_t mod_pitch_offset_scnd = this->mod_pitch_offset_scnd;
-	sei();
+/**
+ * @brief Multiply 'value' by a float coefficient and 2^-'shift' using only
+ * integer arithmetic, truncating toward zero as a float conversion does.
+ * Takes the same few cycles whatever the operands, with or without an FPU.
+ *
+ * @param value the integer operand
+ * @param coefficient the float operand, read as its sign, exponent and mantissa
+ * @param shift extra fraction bits to drop from the product
+ * @return the product, saturated if it overflows 2^62
+ */
+static int64_t multiply_float(uint32_t value, float coefficient, int shift) {
+	uint32_t bits;
+	memcpy(&bits, &coefficient, sizeof(bits));
+	int exponent = bits >> 23 & 0xFF;
+	if (exponent == 0) return 0; // zero, or too small to matter
+	uint64_t product = (uint64_t)value * ((bits & 0x7FFFFF) | 0x800000);
+	exponent -= 127 + 23 + shift;
+	if (exponent >= 7) product = (uint64_t)1 << 62;
+	else if (exponent >= 0) product <<= exponent;
+	else product = exponent > -64 ? product >> -exponent : 0;
+	return bits >> 31 ? -(int64_t)product : (int64_t)product;
+}
 
-	if (s->LOOP == false && tone_phase >= s->MAX_PHASE) return;
+/**
+ * @brief Work out the spec of a note: its gain, and its phase increment and
+ * vibrato and modulation depths at the defined frequency.
+ * Integer arithmetic only, so cheap enough for any caller of playNote().
+ *
+ * @param note filled with the spec
+ * @param sample the sample to play, from the instrument's zone map
+ * @param amp the amplitude level at which playback should occur, 0 to 127
+ * @param frequency frequency of the generated output, in Hz as unsigned Q16.16
+ * (between 0 and the board-specific sample rate)
+ */
+void AudioSynthWavetable::noteSpec(wavetable_note_spec& note, const sample_data* sample, int amp, uint32_t frequency) {
+	note.sample = sample;
+	note.tone_amp = sample->INITIAL_ATTENUATION_SCALAR * uint16_t(amp * (UINT16_MAX / 127)) >> 16;
+
+	uint32_t incr = multiply_float(frequency, sample->PER_HERTZ_PHASE_INCREMENT, TUNING_FRACTION_BITS);
+
+	// within a part per million of a whole number of samples (the sample's
+	// root pitch or octaves above it) is as good as exact, and lets render()
+	// copy samples rather than interpolate them
+	const uint32_t sample_step = 0x80000000u >> (sample->INDEX_BITS - 1);
+	uint32_t whole = (incr + sample_step / 2) / sample_step * sample_step;
+	if (whole && (whole > incr ? whole - incr : incr - whole) <= incr >> 20) incr = whole;
+	note.tone_incr = incr;
+	note.vib_pitch_offset_init = multiply_float(incr, sample->VIBRATO_PITCH_COEFFICIENT_INITIAL, 0);
+	note.vib_pitch_offset_scnd = multiply_float(incr, sample->VIBRATO_PITCH_COEFFICIENT_SECOND, 0);
+	note.mod_pitch_offset_init = multiply_float(incr, sample->MODULATION_PITCH_COEFFICIENT_INITIAL, 0);
+	note.mod_pitch_offset_scnd = multiply_float(incr, sample->MODULATION_PITCH_COEFFICIENT_SECOND, 0);
+
+	// play from the decimated copy that keeps the phase increment at or
+	// below one sample of that copy per output sample
+	int level = 0;
+	uint32_t level_step = sample_step;
+	while (level < sample->MIP_LEVELS && level < sample->INDEX_BITS - 1 && incr > level_step) {
+		level_step *= 2;
+		++level;
+	}
+	note.mip_level = level;
+}
+
+/**
+ * @brief Called by the AudioStream library to fill the audio output buffer.
+ *
+ */
+void AudioSynthWavetable::update(void) {
+	streamed.store(true, std::memory_order_relaxed);
+	if (applyEvents(0) == AUDIO_BLOCK_SAMPLES && state.env_state == STATE_IDLE && !fading) {
+		park();
+		return;
+	}
 
 	audio_block_t* block;
 	block = allocate();
 	if (block == NULL) return;
 
-	uint32_t* p, * end;
-	uint32_t index, scale;
-	int32_t s1, s2;
-	uint32_t tmp1, tmp2;
-
-	TIME_TEST(5000,
-	p = (uint32_t*)block->data;
-	end = p + AUDIO_BLOCK_SAMPLES / 2;
+	if (render(block->data)) transmit(block);
+	release(block);
+	if (state.env_state == STATE_IDLE && !deferred_pending && !fading) park();
+}
 
-	while(p < end) {
-		if (s->LOOP == false && tone_phase >= s->MAX_PHASE) break;
+bool AudioSynthWavetable::park_idle = true;
 
-		int32_t tone_incr_offset = 0;
-		if (vib_count++ > s->VIBRATO_DELAY) {
-			vib_phase += s->VIBRATO_INCREMENT;
-			int32_t vib_scale = vib_phase & 0x80000000 ? 0x40000000 + vib_phase : 0x3FFFFFFF - vib_phase;
-			int32_t vib_pitch_offset = vib_scale >= 0 ? vib_pitch_offset_init : vib_pitch_offset_scnd;
-			tone_incr_offset = multiply_accumulate_32x32_rshift32_rounded(tone_incr_offset, vib_scale, vib_pitch_offset);
+/**
+ * @brief Clear 'active' on an idle voice, so AudioStream::update_all() skips
+ * its update() until post() sets it again for the next event.
+ */
+void AudioSynthWavetable::park(void) {
+	if (!park_idle) return;
+	active = false;
+	// an event posted meanwhile either sees 'active' cleared and sets it, or
+	// is seen here; pairs with the fence in post()
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!events.empty()) active = true;
+}
 
-			tone_incr_offset += (int32_t(vib_scale>>15) * vib_pitch_offset) >> 15;
-		}
+/**
+ * @brief Move the envelope on to its next stage once the current one has run out.
+ * Stages of zero length are passed straight through.
+ *
+ * @param s the sample being played, which holds the stage lengths
+ * @param env_state,env_count,env_mult,env_incr the envelope, updated in place
+ * @return false if the release has ended and the voice is now idle
+ */
+static bool envelope_next_stage(const sample_data* s, envelopeStateEnum& env_state, int32_t& env_count,
+	int32_t& env_mult, int32_t& env_incr) {
+	while (env_count <= 0) switch (env_state) {
+	case STATE_DELAY:
+		env_state = STATE_ATTACK;
+		env_count = s->ATTACK_COUNT;
+		// a zero-length stage must not divide by zero (SDIV yields 0 on the Teensy, traps on x86)
+		env_incr = env_count ? UNITY_GAIN / (env_count * ENVELOPE_PERIOD) : 0;
+		PRINT_ENV(STATE_ATTACK);
+		continue;
+	case STATE_ATTACK:
+		env_mult = UNITY_GAIN;
+		env_state = STATE_HOLD;
+		env_count = s->HOLD_COUNT;
+		env_incr = 0;
+		PRINT_ENV(STATE_HOLD);
+		continue;
+	case STATE_HOLD:
+		env_state = STATE_DECAY;
+		env_count = s->DECAY_COUNT;
+		env_incr = env_count ? (-s->SUSTAIN_MULT) / (env_count * ENVELOPE_PERIOD) : 0;
+		PRINT_ENV(STATE_DECAY);
+		continue;
+	case STATE_DECAY:
+		env_mult = UNITY_GAIN - s->SUSTAIN_MULT;
+		env_state = env_mult < UNITY_GAIN / UINT16_MAX ? STATE_RELEASE : STATE_SUSTAIN;
+		env_incr = 0;
+		continue;
+	case STATE_SUSTAIN:
+		env_count = INT32_MAX;
+		PRINT_ENV(STATE_SUSTAIN);
+		continue;
+	case STATE_RELEASE:
+	default:
+		env_state = STATE_IDLE;
+		PRINT_ENV(STATE_IDLE);
+		return false;
+	}
+	return true;
+}
 
-		int32_t mod_amp = tone_amp;
-		if (mod_count++ > s->MODULATION_DELAY) {
-			mod_phase += s->MODULATION_INCREMENT;
-			int32_t mod_scale = mod_phase & 0x80000000 ? 0x40000000 + mod_phase : 0x3FFFFFFF - mod_phase;
+/**
+ * @brief Upper bound on the peak output of a voice, for comparison with its
+ * idle level. The interpolated sample is at most 2^15 in magnitude, the
+ * amplitude (with the most the modulation LFO can add to it) scales that by
+ * amp / 2^16 and the envelope by (env_mult >> 15) / 2^16, so the bound is in
+ * LSBs times 2^17.
+ *
+ * @param s the sample being played
+ * @param tone_amp the voice's amplitude
+ * @param env_mult the envelope's current gain
+ * @return the bound, 0 if the envelope is at or below zero
+ */
+static uint64_t level_bound(const sample_data* s, uint16_t tone_amp, int32_t env_mult) {
+	int32_t mod_init = s->MODULATION_AMPLITUDE_INITIAL_GAIN, mod_scnd = s->MODULATION_AMPLITUDE_SECOND_GAIN;
+	uint32_t mod_gain = mod_init < 0 ? -mod_init : mod_init;
+	if (uint32_t(mod_scnd < 0 ? -mod_scnd : mod_scnd) > mod_gain) mod_gain = mod_scnd < 0 ? -mod_scnd : mod_scnd;
+	uint64_t amp = tone_amp + (mod_gain >> 3) + 1;
+	return env_mult > 0 ? amp * uint32_t(env_mult >> 15) : 0;
+}
 
-			int32_t mod_pitch_offset = mod_scale >= 0 ? mod_pitch_offset_init : mod_pitch_offset_scnd;
-			tone_incr_offset = multiply_accumulate_32x32_rshift32_rounded(tone_incr_offset, mod_scale, mod_pitch_offset);
+// The voice's settings for one block, read once at its start.
+struct render_options {
+	interpolationModeEnum interpolation;
+	uint32_t idle_level;
+	bool copy_exact;
+};
 
-			int32_t mod_offset = (mod_scale >= 0 ? s->MODULATION_AMPLITUDE_INITIAL_GAIN : s->MODULATION_AMPLITUDE_SECOND_GAIN);
-			mod_scale = multiply_32x32_rshift32(mod_scale, mod_offset);
-			mod_amp = signed_multiply_accumulate_32x16b(mod_amp, mod_scale, mod_amp);
+/**
+ * @brief Render the next block of a voice, specialized for the features of
+ * the sample it plays so the hot loop tests none of them.
+ *
+ * @tparam LOOP the sample loops, rather than playing once to its end
+ * @tparam VIBRATO the vibrato LFO bends the pitch
+ * @tparam MODULATION the modulation LFO bends the pitch and amplitude
+ * @param v the voice's state, advanced over the block
+ * @param options the voice's settings
+ * @param data where the samples go
+ * @param count the number of samples, at most AUDIO_BLOCK_SAMPLES
+ * @return see AudioSynthWavetable::render()
+ */
+template <bool LOOP, bool VIBRATO, bool MODULATION>
+static bool render_block(wavetable_voice_state& v, const render_options& options, int16_t* data, int count) {
+	// everything the loop touches is held in locals, so the compiler can
+	// keep it in registers across the kernel calls
+	const sample_data* s = v.note.sample;
+	uint32_t tone_phase = v.tone_phase;
+	const uint32_t tone_incr = v.note.tone_incr;
+	const uint16_t tone_amp = v.tone_amp;
+	const interpolationModeEnum interpolation = options.interpolation;
+	const int mip_level = v.note.mip_level;
+	const uint32_t idle_level = options.idle_level;
+	const bool copy_exact = options.copy_exact;
+
+	envelopeStateEnum env_state = v.env_state;
+	int32_t env_count = v.env_count;
+	int32_t env_mult = v.env_mult;
+	int32_t env_incr = v.env_incr;
+
+	uint32_t vib_count = v.vib_count;
+	uint32_t vib_phase = v.vib_phase;
+	const int32_t vib_pitch_offset_init = v.note.vib_pitch_offset_init;
+	const int32_t vib_pitch_offset_scnd = v.note.vib_pitch_offset_scnd;
+
+	uint32_t mod_count = v.mod_count;
+	int32_t mod_phase = v.mod_phase;
+	const int32_t mod_pitch_offset_init = v.note.mod_pitch_offset_init;
+	const int32_t mod_pitch_offset_scnd = v.note.mod_pitch_offset_scnd;
+
+	// a one-shot sample that has played out is silent for good
+	if (!LOOP && tone_phase >= s->MAX_PHASE) env_state = STATE_IDLE;
+	// from the hold on the envelope only falls, so a voice whose peak output
+	// is already below the floor stays there
+	else if (env_state >= STATE_HOLD && level_bound(s, tone_amp, env_mult) < idle_level) env_state = STATE_IDLE;
+	const int16_t* sample = mip_level ? s->MIP_SAMPLES[mip_level - 1] : s->sample;
+	const int index_bits = s->INDEX_BITS - mip_level;
+	const uint32_t length = s->GUARD_SAMPLES >= WAVETABLE_GUARD_SAMPLES ? WAVETABLE_GUARDED : (s->MAX_PHASE >> (32 - index_bits)) + 1;
+
+	int16_t* out, * out_end, * env_end;
+	int lfo_remaining = 0;
+	uint32_t incr = 0;
+	int32_t mod_amp = 0;
+	// 'data' is only written once something audible has been rendered, so
+	// a block that is silent throughout (a delay, say) is never touched
+	bool audible = false, silent = false;
+
+	if (env_state != STATE_IDLE) {
+	TIME_TEST(5000,
+	out = data;
+	out_end = data + count;
+
+	// One pass over the block: each run of samples sharing an envelope ramp
+	// is split at LFO periods and at the loop end, and every piece goes
+	// through the fused interpolation and envelope kernel, unless the
+	// envelope keeps it at zero. Silent pieces only advance the phase.
+	while (out < out_end) {
+		if (env_count <= 0 && envelope_next_stage(s, env_state, env_count, env_mult, env_incr) == false) {
+			// the release ended: the rest of the block is silent
+			for (; audible && out < out_end; ++out) *out = 0;
+			break;
+		}
+		env_end = out + (env_count < (out_end - out) / ENVELOPE_PERIOD ? env_count * ENVELOPE_PERIOD : out_end - out);
+		env_count -= (env_end - out) / ENVELOPE_PERIOD;
+		// the ramp is linear, so it is silent throughout if it is at both ends
+		silent = tone_amp == 0 || ((env_mult >> 15) == 0 && ((env_mult + (env_end - out) * env_incr) >> 15) == 0);
+		if (!silent && !audible) {
+			for (int16_t* z = data; z < out; ++z) *z = 0;
+			audible = true;
 		}
 
-		for (int i = LFO_PERIOD/2; i; --i, ++p) {
-			index = tone_phase >> (32 - s->INDEX_BITS);
-			tmp1 = *((uint32_t*)(s->sample + index));
-			scale = (tone_phase << s->INDEX_BITS) >> 16;
-			s1 = signed_multiply_32x16t(scale, tmp1);
-			s1 = signed_multiply_accumulate_32x16b(s1, 0xFFFF - scale, tmp1);
-			s1 = signed_multiply_32x16b(mod_amp, s1);
-
-			tone_phase += tone_incr + tone_incr_offset;
-			if (s->LOOP == false && tone_phase >= s->MAX_PHASE) break;
-			tone_phase = s->LOOP && tone_phase >= s->LOOP_PHASE_END ? tone_phase - s->LOOP_PHASE_LENGTH : tone_phase;
-
-			index = tone_phase >> (32 - s->INDEX_BITS);
-			tmp1 = *((uint32_t*)(s->sample + index));
-			scale = (tone_phase << s->INDEX_BITS) >> 16;
-			s2 = signed_multiply_32x16t(scale, tmp1);
-			s2 = signed_multiply_accumulate_32x16b(s2, 0xFFFF - scale, tmp1);
-			s2 = signed_multiply_32x16b(mod_amp, s2);
-
-			*p = pack_16b_16b(s2, s1);
-
-			tone_phase += tone_incr + tone_incr_offset;
-			if (s->LOOP == false && tone_phase >= s->MAX_PHASE) break;
-			tone_phase = s->LOOP && tone_phase >= s->LOOP_PHASE_END ? tone_phase - s->LOOP_PHASE_LENGTH : tone_phase;
+		while (out < env_end) {
+			if (!LOOP && tone_phase >= s->MAX_PHASE) {
+				// a one-shot sample that ran out leaves the rest silent, but
+				// the envelope still advances over it
+				env_mult += (env_end - out) * env_incr;
+				if (audible) for (; out < env_end; ++out) *out = 0;
+				out = env_end;
+				break;
+			}
+
+			if (lfo_remaining == 0) {
+				int32_t tone_incr_offset = 0;
+				if (VIBRATO && vib_count++ > s->VIBRATO_DELAY) {
+					vib_phase += s->VIBRATO_INCREMENT;
+					int32_t vib_scale = vib_phase & 0x80000000 ? 0x40000000 + vib_phase : 0x3FFFFFFF - vib_phase;
+					int32_t vib_pitch_offset = vib_scale >= 0 ? vib_pitch_offset_init : vib_pitch_offset_scnd;
+					tone_incr_offset = multiply_accumulate_32x32_rshift32_rounded(tone_incr_offset, vib_scale, vib_pitch_offset);
+
+					tone_incr_offset += (int32_t(vib_scale>>15) * vib_pitch_offset) >> 15;
+				}
+
+				mod_amp = tone_amp;
+				if (MODULATION && mod_count++ > s->MODULATION_DELAY) {
+					mod_phase += s->MODULATION_INCREMENT;
+					int32_t mod_scale = mod_phase & 0x80000000 ? 0x40000000 + mod_phase : 0x3FFFFFFF - mod_phase;
+
+					int32_t mod_pitch_offset = mod_scale >= 0 ? mod_pitch_offset_init : mod_pitch_offset_scnd;
+					tone_incr_offset = multiply_accumulate_32x32_rshift32_rounded(tone_incr_offset, mod_scale, mod_pitch_offset);
+
+					int32_t mod_offset = (mod_scale >= 0 ? s->MODULATION_AMPLITUDE_INITIAL_GAIN : s->MODULATION_AMPLITUDE_SECOND_GAIN);
+					mod_scale = multiply_32x32_rshift32(mod_scale, mod_offset);
+					mod_amp = signed_multiply_accumulate_32x16b(mod_amp, mod_scale, mod_amp);
+				}
+
+				incr = tone_incr + tone_incr_offset;
+				lfo_remaining = LFO_PERIOD;
+			}
+
+			const uint32_t boundary = LOOP ? s->LOOP_PHASE_END : s->MAX_PHASE;
+			int remaining = lfo_remaining < env_end - out ? lfo_remaining : env_end - out;
+			lfo_remaining -= remaining;
+			while (remaining) {
+				// samples whose phase advance stays below the loop end (or sample end)
+				// need no wrap or stop checks and go through the vector kernel
+				int span = remaining;
+				if (tone_phase >= boundary) span = 0;
+				else if (incr && (boundary - 1 - tone_phase) / incr < uint32_t(span)) span = (boundary - 1 - tone_phase) / incr;
+				if (silent) {
+					if (audible) for (int i = 0; i < span; ++i) out[i] = 0;
+				} else if (copy_exact && wavetable_exact_ratio(tone_phase, incr, index_bits)) {
+					// every phase in the span lands on a whole sample (the root pitch
+					// or whole octaves above it): copy rather than interpolate
+					wavetable_copy_envelope(out, span, tone_phase >> (32 - index_bits), incr >> (32 - index_bits),
+						sample, interpolation == INTERPOLATION_LINEAR, mod_amp, env_mult, env_incr);
+				} else {
+					wavetable_interpolate_mode_envelope(interpolation, out, span, tone_phase, incr, sample, length, index_bits, mod_amp, env_mult, env_incr);
+				}
+				out += span;
+				tone_phase += span * incr;
+				env_mult += span * env_incr;
+				remaining -= span;
+				if (remaining == 0) break;
+
+				// the sample that crosses the boundary
+				if (!silent) wavetable_interpolate_mode_envelope(interpolation, out, 1, tone_phase, incr, sample, length, index_bits, mod_amp, env_mult, env_incr);
+				else if (audible) *out = 0;
+				++out;
+				--remaining;
+				tone_phase += incr;
+				env_mult += env_incr;
+				if (!LOOP && tone_phase >= s->MAX_PHASE) {
+					// the paired-sample loop this replaces dropped a sample that
+					// ended the sample on an even index; keep its output unchanged
+					if (audible && ((out - data) & 1)) out[-1] = 0;
+					// the LFO stops with the sample
+					lfo_remaining = 0;
+					break;
+				}
+				tone_phase = LOOP && tone_phase >= s->LOOP_PHASE_END ? tone_phase - s->LOOP_PHASE_LENGTH : tone_phase;
+			}
 		}
 	}
 	); //end TIME_TEST
+	}
 
-	p = (uint32_t *)block->data;
-	end = p + AUDIO_BLOCK_SAMPLES / 2;
+	v.tone_phase = tone_phase;
+	v.env_state = env_state;
+	v.env_count = env_count;
+	v.env_mult = env_mult;
+	v.env_incr = env_incr;
+	v.vib_count = vib_count;
+	v.vib_phase = vib_phase;
+	v.mod_count = mod_count;
+	v.mod_phase = mod_phase;
+	return audible;
+}
 
-	while (p < end) {
-		if (env_count <= 0) switch (env_state) {
-		case STATE_DELAY:
-			env_state = STATE_ATTACK;
-			env_count = s->ATTACK_COUNT;
-			env_incr = UNITY_GAIN / (env_count * ENVELOPE_PERIOD);
-			PRINT_ENV(STATE_ATTACK);
-			continue;
-		case STATE_ATTACK:
-			env_mult = UNITY_GAIN;
-			env_state = STATE_HOLD;
-			env_count = s->HOLD_COUNT;
-			env_incr = 0;
-			PRINT_ENV(STATE_HOLD);
-			continue;
-		case STATE_HOLD:
-			env_state = STATE_DECAY;
-			env_count = s->DECAY_COUNT;
-			env_incr = (-s->SUSTAIN_MULT) / (env_count * ENVELOPE_PERIOD);
-			PRINT_ENV(STATE_DECAY);
-			continue;
-		case STATE_DECAY:
-			env_mult = UNITY_GAIN - s->SUSTAIN_MULT;
-			env_state = env_mult < UNITY_GAIN / UINT16_MAX ? STATE_RELEASE : STATE_SUSTAIN;
-			env_incr = 0;
-			continue;
-		case STATE_SUSTAIN:
-			env_count = INT32_MAX;
-			PRINT_ENV(STATE_SUSTAIN);
-			continue;
-		case STATE_RELEASE:
-			env_state = STATE_IDLE;
-			for (; p < end; ++p) *p = 0;
-			PRINT_ENV(STATE_IDLE);
-			continue;
-		default:
-			p = end;
-			PRINT_ENV(DEFAULT);
-			continue;
-		}
+// render_block() for each combination of renderVariant() flags.
+static bool (* const render_variants[RENDER_VARIANT_COUNT])(wavetable_voice_state&, const render_options&, int16_t*, int) = {
+	render_block<false, false, false>, render_block<true, false, false>,
+	render_block<false, true, false>, render_block<true, true, false>,
+	render_block<false, false, true>, render_block<true, false, true>,
+	render_block<false, true, true>, render_block<true, true, true>,
+};
 
-		env_mult += env_incr;
-		tmp1 = signed_multiply_32x16b(env_mult >> 15, p[0]);
-		env_mult += env_incr;
-		tmp2 = signed_multiply_32x16t(env_mult >> 15, p[0]);
-		p[0] = pack_16b_16b(tmp2, tmp1);
-		env_mult += env_incr;
-		tmp1 = signed_multiply_32x16b(env_mult >> 15, p[1]);
-		env_mult += env_incr;
-		tmp2 = signed_multiply_32x16t(env_mult >> 15, p[1]);
-		p[1] = pack_16b_16b(tmp2, tmp1);
-		env_mult += env_incr;
-		tmp1 = signed_multiply_32x16b(env_mult >> 15, p[2]);
-		env_mult += env_incr;
-		tmp2 = signed_multiply_32x16t(env_mult >> 15, p[2]);
-		p[2] = pack_16b_16b(tmp2, tmp1);
-		env_mult += env_incr;
-		tmp1 = signed_multiply_32x16b(env_mult >> 15, p[3]);
-		env_mult += env_incr;
-		tmp2 = signed_multiply_32x16t(env_mult >> 15, p[3]);
-		p[3] = pack_16b_16b(tmp2, tmp1);
-
-		p += ENVELOPE_PERIOD / 2;
-		env_count--;
-	}
+bool AudioSynthWavetable::render_specialized = true;
 
-	cli();
-	if (this->state_change == false) {
-		this->tone_phase = tone_phase;
-		this->env_state = env_state;
-		this->env_count = env_count;
-		this->env_mult = env_mult;
-		this->env_incr = env_incr;
-		if (this->env_state != STATE_IDLE) {
-			this->vib_count = vib_count;
-			this->vib_phase = vib_phase;
-			this->mod_count = mod_count;
-			this->mod_phase = mod_phase;
-		} else {
-			this->vib_count = this->mod_count = 0;
-			this->vib_phase = this->mod_phase = TRIANGLE_INITIAL_PHASE;
-		}
+/**
+ * @brief Render 'count' samples of a voice's state through the variant of
+ * the render loop for its sample.
+ */
+static bool render_voice(wavetable_voice_state& v, const render_options& options, int16_t* data, int count) {
+	// dispatch once per span, so the loop itself never tests the sample's features
+	int variant = AudioSynthWavetable::renderVariant(*v.note.sample);
+	if (!options.copy_exact) variant |= RENDER_VIBRATO | RENDER_MODULATION;
+	return render_variants[variant](v, options, data, count);
+}
+
+/**
+ * @brief Pick the render loop variant for a sample: an LFO is left out
+ * where it cannot change the output, as when it never moves off its
+ * initial phase (a zero increment) or only scales zero offsets.
+ *
+ * @param s a sample
+ * @return RENDER_LOOP, RENDER_VIBRATO and RENDER_MODULATION or'd together
+ */
+int AudioSynthWavetable::renderVariant(const sample_data& s) {
+	bool vibrato = s.VIBRATO_INCREMENT != 0
+		&& (s.VIBRATO_PITCH_COEFFICIENT_INITIAL != 0.0 || s.VIBRATO_PITCH_COEFFICIENT_SECOND != 0.0);
+	bool modulation = s.MODULATION_INCREMENT != 0
+		&& (s.MODULATION_PITCH_COEFFICIENT_INITIAL != 0.0 || s.MODULATION_PITCH_COEFFICIENT_SECOND != 0.0
+		|| s.MODULATION_AMPLITUDE_INITIAL_GAIN != 0 || s.MODULATION_AMPLITUDE_SECOND_GAIN != 0);
+	return (s.LOOP ? RENDER_LOOP : 0) | (vibrato ? RENDER_VIBRATO : 0) | (modulation ? RENDER_MODULATION : 0);
+}
+
+/**
+ * @brief Render the next block of this voice into 'data', after applying
+ * the events posted since the last block (see applyEvents()).
+ * Performs interpolation and enveloping of output audio values in a single
+ * pass, so each sample is written once, through the variant of the render
+ * loop specialized for the features of the sample (see renderVariant()).
+ * An event posted with an offset splits the block there: the samples
+ * before it are rendered as the voice was, and the rest after applying it.
+ * Used by update() and by AudioSynthWavetablePoly, which mixes many voices
+ * into one block.
+ *
+ * @param data buffer of AUDIO_BLOCK_SAMPLES samples, 4-byte aligned
+ * @return false if the voice is silent for the whole block and 'data' was
+ * left untouched; its phase and envelope still advance, and a voice below
+ * its idle floor (see setIdleFloor()) or past the end of a one-shot sample
+ * goes idle
+ */
+bool AudioSynthWavetable::render(int16_t* data) {
+	int position = 0, next = applyEvents(0);
+	if (next == AUDIO_BLOCK_SAMPLES) {
+		// nothing due within the block, the usual case
+		bool audible = renderSpan(data, AUDIO_BLOCK_SAMPLES);
+		publish();
+		return audible;
 	}
 
-	sei();
+	bool audible = false;
+	for (;;) {
+		bool part = renderSpan(data + position, next - position);
+		// each span leaves 'data' untouched when silent; fill in around the audible ones
+		if (part && !audible) memset(data, 0, position * sizeof(int16_t));
+		else if (!part && audible) memset(data + position, 0, (next - position) * sizeof(int16_t));
+		audible |= part;
+		if (next == AUDIO_BLOCK_SAMPLES) break;
+		position = next;
+		next = applyEvents(position);
+	}
+	publish();
+	return audible;
+}
 
-	transmit(block);
-	release(block);
+/**
+ * @brief Render 'count' samples of the voice with its current state, and of
+ * a stolen note fading out under it (see stealNote()).
+ *
+ * @param data where the samples go
+ * @param count a value between 1 and AUDIO_BLOCK_SAMPLES
+ * @return false if they are silent and 'data' was left untouched
+ */
+bool AudioSynthWavetable::renderSpan(int16_t* data, int count) {
+	render_options options;
+	options.interpolation = interpolation.load(std::memory_order_relaxed);
+	options.idle_level = idle_level.load(std::memory_order_relaxed);
+	options.copy_exact = render_specialized;
+
+	bool audible = state.env_state != STATE_IDLE && render_voice(state, options, data, count);
+	if (!fading) return audible;
+
+	int16_t tail[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	if (render_voice(fade, options, tail, count)) {
+		if (!audible) memcpy(data, tail, count * sizeof(int16_t));
+		else for (int i = 0; i < count; ++i) {
+			int32_t sum = data[i] + tail[i];
+			data[i] = sum > 32767 ? 32767 : sum < -32768 ? -32768 : sum;
+		}
+		audible = true;
+	}
+	fading = fade.env_state != STATE_IDLE;
+	return audible;
 }
@@ -31,6 +31,8 @@
 #include <math.h>
 #include <sample_data.h>
 #include <stdint.h>
+#include "wavetable_kernels.h"
+#include "wavetable_events.h"
 
 #define UNITY_GAIN INT32_MAX // Max amplitude
 #define DEFAULT_AMPLITUDE 127
@@ -40,9 +42,33 @@
 #define LFO_PERIOD (AUDIO_BLOCK_SAMPLES/(1 << (LFO_SMOOTHNESS-1)))
 
 #define ENVELOPE_PERIOD 8
+#define DEFAULT_IDLE_FLOOR -96.0 // dB below full scale, about half an LSB of output
+#define TUNING_FRACTION_BITS 16 // tuning tables hold frequencies in Hz as unsigned Q16.16
+#define QUICK_KILL_PERIODS 8 // envelope periods a stolen note fades out over: 64 samples, 1.5 ms
+
+// Features of a sample that select the specialized render loop playing it.
+enum renderVariantEnum { RENDER_LOOP = 1, RENDER_VIBRATO = 2, RENDER_MODULATION = 4, RENDER_VARIANT_COUNT = 8 };
 
 enum envelopeStateEnum { STATE_IDLE, STATE_DELAY, STATE_ATTACK, STATE_HOLD, STATE_DECAY, STATE_SUSTAIN, STATE_RELEASE };
 
+// A voice's playback state: the note it plays and how far it has got.
+// Only render() reads or writes it, so it is neither volatile nor guarded.
+struct wavetable_voice_state {
+	wavetable_note_spec note;
+	uint32_t tone_phase;
+	uint16_t tone_amp;
+
+	envelopeStateEnum env_state;
+	int32_t env_count;
+	int32_t env_mult;
+	int32_t env_incr;
+
+	uint32_t vib_count;
+	uint32_t vib_phase;
+	uint32_t mod_count;
+	int32_t mod_phase;
+};
+
 class AudioSynthWavetable : public AudioStream
 {
 public:
@@ -55,17 +81,18 @@ public:
 	 * @brief Set the instrument_data struct to be used as the playback instrument.
 	 *
 	 * A wavetable uses a set of samples to generate sound.
-	 * This function is used to set the instrument samples.
+	 * This function is used to set the instrument samples. The note playing
+	 * is cut off at the next block, unless 'cut_off' is false.
 	 * @param instrument a struct of type instrument_data, commonly prodced from a 
 	 * decoded SoundFont file using the SoundFont Decoder Script which accompanies this library.
+	 * @param cut_off false to let the note playing sound on, e.g. to fade
+	 * out under the next note with stealNote(); decoded samples stay valid
 	 */
-	void setInstrument(const instrument_data& instrument) {
-		cli();
-		this->instrument = &instrument;
-		current_sample = NULL;
-		env_state = STATE_IDLE;
-		state_change = true;
-		sei();
+	void setInstrument(const instrument_data& instrument, bool cut_off = true) {
+		noteSamples(instrument); // build the zone map now, not at the first note
+		this->instrument.store(&instrument, std::memory_order_release);
+		if (!cut_off) return;
+		post(makeEvent(EVENT_SILENCE, 0));
 	}
 
 	/**
@@ -74,12 +101,68 @@ public:
 	 * A value of 0 will set the synth output to minimum amplitude
 	 * (i.e., no output). A value of 1 will set the output to the
 	 * maximum amplitude. Amplitude is set linearly with intermediate
-	 * values.
+	 * values. Takes effect from the next rendered block, in order with the
+	 * notes played before and after it.
 	 * @param v a value between 0.0 and 1.0
 	 */
 	void amplitude(float v) {
 		v = (v < 0.0) ? 0.0 : (v > 1.0) ? 1.0 : v;
-		tone_amp = (uint16_t)(UINT16_MAX*v);
+		post(makeEvent(EVENT_AMPLITUDE, 0, (uint16_t)(UINT16_MAX*v)));
+	}
+
+	/**
+	 * @brief Select how sample values are interpolated between indices.
+	 *
+	 * Higher-order modes cost more cycles per sample but alias less,
+	 * most audibly on samples pitched well below their recorded pitch.
+	 * Takes effect from the next rendered block.
+	 * @param mode one of INTERPOLATION_DROP, INTERPOLATION_LINEAR (default),
+	 * INTERPOLATION_HERMITE or INTERPOLATION_SINC
+	 */
+	void setInterpolation(interpolationModeEnum mode) {
+		interpolation.store(mode < INTERPOLATION_COUNT ? mode : INTERPOLATION_LINEAR, std::memory_order_relaxed);
+	}
+
+	interpolationModeEnum getInterpolation(void) { return interpolation.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Set the frequency playNote() plays each note at.
+	 *
+	 * The table is only read at note-on, which then costs a lookup and a
+	 * few integer multiplies. Takes effect from the next note.
+	 * @param frequencies NOTE_COUNT frequencies in Hz, unsigned Q16.16, as
+	 * built by tuningTable(); it must stay valid while the voice plays.
+	 * NULL restores equal temperament.
+	 */
+	void setTuning(const uint32_t* frequencies) {
+		tuning.store(frequencies ? frequencies : equal_temperament, std::memory_order_release);
+	}
+
+	const uint32_t* getTuning(void) { return tuning.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Set the level below which a fading voice goes idle.
+	 *
+	 * Once its attack is over a voice can only get quieter, so as soon as
+	 * its peak output falls below this level it stops rendering and frees
+	 * itself, as if its release had ended.
+	 * @param decibels level relative to full scale, at most 0;
+	 * -INFINITY keeps voices playing until their release ends
+	 */
+	void setIdleFloor(float decibels) {
+		idle_level.store(idleLevel(decibels), std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Convert an idle floor to the bound render() compares it with:
+	 * the peak output level in LSBs, times 2^17.
+	 *
+	 * @param decibels level relative to full scale
+	 * @return 0 (never idle) to 32767 * 2^17 (0 dB)
+	 */
+	static uint32_t idleLevel(float decibels) {
+		if (decibels > 0.0) decibels = 0.0;
+		return 32767.0 * 131072.0 * powf(10.0, decibels / 20.0);
 	}
 
 	/**
@@ -107,6 +190,25 @@ public:
 		return powf(2.0, exp);
 	}
 
+	/**
+	 * @brief The equal-tempered frequency of a MIDI note (A4 = 440 Hz),
+	 * evaluated at compile time for the default tuning table.
+	 *
+	 * @param note a value between 0 and 127
+	 * @return the frequency in Hz, unsigned Q16.16
+	 */
+	static constexpr uint32_t equalTemperedFrequency(int note) {
+		// C-1 = 440 Hz / 2^(69/12), doubled each octave, times the semitones above C
+		return 8.1757989156437073 * (1 << note / 12) * semitoneRatio(note % 12) * (1 << TUNING_FRACTION_BITS) + 0.5;
+	}
+
+	static constexpr double semitoneRatio(int semitones) {
+		return semitones == 0 ? 1.0 : 1.0594630943592953 * semitoneRatio(semitones - 1);
+	}
+
+	// The default tuning table, equalTemperedFrequency() of every note.
+	static const uint32_t equal_temperament[NOTE_COUNT];
+
 	/**
 	 * @brief Convert a frequency to the corressponding
 	 * MIDI note value.
@@ -118,45 +220,158 @@ public:
 		return (12.0 / 440.0) * log2f(freq) + 69.5;
 	}
 
+	/**
+	 * @brief Find the sample of the current instrument that plays 'note' at
+	 * 'velocity', from the instrument's key and velocity zone map.
+	 *
+	 * Constant-time; notes and velocities outside 0-127 are clamped.
+	 * @param note a MIDI note number
+	 * @param velocity a MIDI velocity
+	 * @return an index into the instrument's samples
+	 */
+	int sampleIndex(int note, int velocity = DEFAULT_AMPLITUDE) {
+		return sampleIndex(*instrument.load(std::memory_order_acquire), note, velocity);
+	}
+
+	/**
+	 * @brief sampleIndex() for a given instrument, which may not be the
+	 * voice's by the time the index is used.
+	 */
+	static int sampleIndex(const instrument_data& instrument, int note, int velocity) {
+		note = note < 0 ? 0 : note >= NOTE_COUNT ? NOTE_COUNT - 1 : note;
+		const uint8_t* note_samples = noteSamples(instrument);
+		if (note_samples == NULL) return scanNoteRanges(instrument, note);
+		if (instrument.note_samples == NULL || instrument.velocity_bands == NULL) return note_samples[note];
+		velocity = velocity < 0 ? 0 : velocity > 127 ? 127 : velocity;
+		return note_samples[note * instrument.velocity_band_count + instrument.velocity_bands[velocity]];
+	}
+
 	// Defined in AudioSynthWavetable.cpp
+	static const uint8_t* noteSamples(const instrument_data& instrument);
+	static int scanNoteRanges(const instrument_data& instrument, int note);
+	static void tuningTable(uint32_t* frequencies, const float* cents, float reference = 440.0);
+	static int renderVariant(const sample_data& s);
 	void stop(void);
+	void stop(int offset);
 	void playFrequency(float freq, int amp = DEFAULT_AMPLITUDE);
+	void playFrequency(float freq, int amp, int offset);
 	void playNote(int note, int amp = DEFAULT_AMPLITUDE);
-	bool isPlaying(void) { return env_state != STATE_IDLE; }
+	void playNote(int note, int amp, int offset);
+	void stealNote(int note, int amp = DEFAULT_AMPLITUDE, int offset = 0);
+	void quickKill(int offset = 0);
 	virtual void update(void);
-	
-	envelopeStateEnum getEnvState(void) { return env_state; }
+	bool render(int16_t* data);
+
+	/**
+	 * @brief Whether the voice is sounding, or has a note waiting to start
+	 * at the next block.
+	 */
+	bool isPlaying(void) {
+		return pending_notes.load(std::memory_order_acquire) != 0 || published_state.load(std::memory_order_acquire) != STATE_IDLE;
+	}
+
+	/**
+	 * @brief The stage of the voice's envelope; a note waiting to start at
+	 * the next block counts as in its delay.
+	 */
+	envelopeStateEnum getEnvState(void) {
+		return pending_notes.load(std::memory_order_acquire) != 0 ? STATE_DELAY
+			: (envelopeStateEnum)published_state.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief The number of events dropped because the voice's queue was full,
+	 * i.e. more than WAVETABLE_EVENT_QUEUE_SIZE calls between two blocks.
+	 */
+	uint32_t droppedEvents(void) { return dropped_events.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Have render() tell 'listener' each time the voice goes idle,
+	 * so whoever allocates voices need not poll isPlaying(). Set it before
+	 * the voice first plays.
+	 *
+	 * @param listener told of the voice going idle, or NULL for no one
+	 * @param id passed to the listener to name the voice
+	 */
+	void setIdleListener(WavetableIdleListener* listener, int id) {
+		idle_listener = listener;
+		idle_id = id;
+	}
+
+	/**
+	 * @brief Choose whether voices render through the loop specialized for
+	 * each sample's features (the default) or always through the one with
+	 * both LFOs, interpolating even where the pitch is a whole number of
+	 * samples per output sample; both give the same output. For benchmarks
+	 * and tests.
+	 *
+	 * @param on true to specialize
+	 */
+	static void specializeRender(bool on) { render_specialized = on; }
+
+	/**
+	 * @brief Choose whether an idle voice drops out of the audio update
+	 * (the default), so that AudioStream::update_all() skips it until it is
+	 * given an event, or has update() called every block regardless. For
+	 * benchmarks; voices parked already stay parked until their next event.
+	 *
+	 * @param on true to skip idle voices
+	 */
+	static void parkIdle(bool on) { park_idle = on; }
 
 private:
-	void setState(int note, int amp, float freq);
-	void setFrequency(float freq);
-
-	volatile bool state_change = false;
-
-	volatile const instrument_data* instrument = NULL;
-	volatile const sample_data* current_sample = NULL;
-
-	//sample output state
-	volatile uint32_t tone_phase = 0;
-	volatile uint32_t tone_incr = 0;
-	volatile uint16_t tone_amp = 0;
-
-	//volume environment state
-	volatile envelopeStateEnum  env_state = STATE_IDLE;
-	volatile int32_t env_count = 0;
-	volatile int32_t env_mult = 0;
-	volatile int32_t env_incr = 0;
-
-	//vibrato LFO state
-	volatile uint32_t vib_count = 0;
-	volatile uint32_t vib_phase = 0;
-	volatile int32_t vib_pitch_offset_init = 0;
-	volatile int32_t vib_pitch_offset_scnd = 0;
-
-	//modulation LFO state
-	volatile uint32_t mod_count = 0;
-	volatile uint32_t mod_phase = TRIANGLE_INITIAL_PHASE;
-	volatile int32_t mod_pitch_offset_init = 0;
-	volatile int32_t mod_pitch_offset_scnd = 0;
+	static bool render_specialized;
+	static bool park_idle;
+
+	bool post(const wavetable_event& event);
+
+	/**
+	 * @brief An event with every field set: 'offset' clamped to the next
+	 * block, and an empty note for postNote() to fill in.
+	 *
+	 * @param type a wavetableEventEnum
+	 * @param offset the sample of the next block it applies at
+	 * @param amplitude EVENT_AMPLITUDE's level, 0-UINT16_MAX
+	 */
+	static wavetable_event makeEvent(wavetableEventEnum type, int offset, uint16_t amplitude = 0) {
+		wavetable_event event;
+		event.type = type;
+		event.amplitude = amplitude;
+		event.offset = offset < 0 ? 0 : offset >= AUDIO_BLOCK_SAMPLES ? AUDIO_BLOCK_SAMPLES - 1 : offset;
+		event.note = wavetable_note_spec();
+		return event;
+	}
+	void postNote(int note, int amp, uint32_t frequency, int offset, wavetableEventEnum type);
+	int applyEvents(int position);
+	void applyEvent(const wavetable_event& event);
+	void startNote(const wavetable_note_spec& note);
+	void publish(void);
+	void park(void);
+	bool renderSpan(int16_t* data, int count);
+	static void noteSpec(wavetable_note_spec& note, const sample_data* sample, int amp, uint32_t frequency);
+
+	// control side: set by the calls above and read by those that post events
+	std::atomic<const instrument_data*> instrument{NULL};
+	std::atomic<const uint32_t*> tuning{equal_temperament};
+	std::atomic<interpolationModeEnum> interpolation{INTERPOLATION_LINEAR};
+	std::atomic<uint32_t> idle_level{idleLevel(DEFAULT_IDLE_FLOOR)};
+	WavetableEventQueue events;
+	std::atomic<uint8_t> pending_notes{0};
+	std::atomic<uint32_t> dropped_events{0};
+	std::atomic<bool> streamed{false}; // updated by AudioStream, so post() may wake it
+
+	// audio side: changed only by render(), which publishes the envelope
+	// stage for isPlaying() and getEnvState()
+	wavetable_voice_state state = {};
+	std::atomic<uint8_t> published_state{STATE_IDLE};
+	wavetable_event deferred;      // taken from the queue, due later in the block
+	bool deferred_pending = false;
+	bool sounding = false;         // not idle, or a note started, when last published
+	wavetable_voice_state fade = {}; // a stolen note, fading out under the new one
+	bool fading = false;
+
+	// set before the voice plays, then only read by render()
+	WavetableIdleListener* idle_listener = NULL;
+	int idle_id = 0;
 };
 
@@ -0,0 +1,213 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "AudioSynthWavetable.h"
+#ifdef HOST_BUILD
+#include "render_pool.h"
+#endif
+
+/**
+ * @brief A pool of N wavetable voices that is a single AudioStream object.
+ *
+ * Each playing voice is rendered with the same kernel as a standalone
+ * AudioSynthWavetable and summed into one 32-bit accumulator, so the pool
+ * allocates and transmits one audio block per update no matter how many
+ * voices are sounding. This replaces an array of AudioSynthWavetable objects
+ * feeding a cascade of AudioMixer4 objects.
+ *
+ * Voices are addressed with operator[] and used exactly like standalone
+ * AudioSynthWavetable objects; they must not be connected to anything.
+ */
+template <int N>
+class AudioSynthWavetablePoly : public AudioStream
+{
+public:
+	/**
+	 * Class constructor.
+	 */
+	AudioSynthWavetablePoly(void) : AudioStream(0, NULL) {}
+
+	/**
+	 * @brief Access voice 'i' of the pool.
+	 *
+	 * @param i a value between 0 and N-1
+	 * @return the voice, to be used like a standalone AudioSynthWavetable
+	 */
+	AudioSynthWavetable& operator[](int i) { return voices[i]; }
+
+	/**
+	 * @brief The number of voices in the pool.
+	 */
+	int size(void) const { return N; }
+
+	/**
+	 * @brief Set the instrument of every voice in the pool.
+	 *
+	 * @param instrument a struct of type instrument_data
+	 */
+	void setInstrument(const instrument_data& instrument) {
+		for (int i = 0; i < N; ++i) voices[i].setInstrument(instrument);
+	}
+
+	/**
+	 * @brief Set the amplitude of every voice in the pool.
+	 *
+	 * @param v a value between 0.0 and 1.0
+	 */
+	void amplitude(float v) {
+		for (int i = 0; i < N; ++i) voices[i].amplitude(v);
+	}
+
+	/**
+	 * @brief Set the interpolation mode of every voice in the pool.
+	 *
+	 * @param mode see AudioSynthWavetable::setInterpolation()
+	 */
+	void setInterpolation(interpolationModeEnum mode) {
+		for (int i = 0; i < N; ++i) voices[i].setInterpolation(mode);
+	}
+
+	/**
+	 * @brief Set the idle floor of every voice in the pool.
+	 *
+	 * @param decibels see AudioSynthWavetable::setIdleFloor()
+	 */
+	void setIdleFloor(float decibels) {
+		for (int i = 0; i < N; ++i) voices[i].setIdleFloor(decibels);
+	}
+
+	/**
+	 * @brief Set the tuning table of every voice in the pool.
+	 *
+	 * @param frequencies see AudioSynthWavetable::setTuning()
+	 */
+	void setTuning(const uint32_t* frequencies) {
+		for (int i = 0; i < N; ++i) voices[i].setTuning(frequencies);
+	}
+
+	/**
+	 * @brief Set the gain applied to the sum of all voices.
+	 *
+	 * Works like AudioMixer4::gain(); the summed output saturates, so with
+	 * many voices sounding at once a gain below 1.0 is usually needed.
+	 * @param g a value between 0.0 and 32767.0
+	 */
+	void gain(float g) {
+		g = (g < 0.0) ? 0.0 : (g > 32767.0) ? 32767.0 : g;
+		multiplier = g * 65536.0f;
+	}
+
+	/**
+	 * @brief The number of voices that are currently playing.
+	 */
+	int activeVoices(void) {
+		int count = 0;
+		for (int i = 0; i < N; ++i) count += voices[i].isPlaying();
+		return count;
+	}
+
+#ifdef HOST_BUILD
+	/**
+	 * @brief Render the voices on a pool of worker threads (host only).
+	 *
+	 * Each worker sums the voices it renders into its own accumulator and
+	 * the accumulators are added up at the end; integer sums do not depend
+	 * on the order, so the output is bit-identical to rendering serially.
+	 * @param pool the workers, shared with other pools if need be;
+	 * NULL renders on the calling thread
+	 */
+	void setRenderPool(WavetableRenderPool* pool) { render_pool = pool; }
+#endif
+
+	virtual void update(void);
+
+private:
+	AudioSynthWavetable voices[N];
+	int32_t multiplier = 65536;
+#ifdef HOST_BUILD
+	WavetableRenderPool* render_pool = NULL;
+	static void render_voice(void* context, int item, WavetableRenderPool::accumulator& out);
+#endif
+};
+
+#ifdef HOST_BUILD
+template <int N>
+void AudioSynthWavetablePoly<N>::render_voice(void* context, int item, WavetableRenderPool::accumulator& out) {
+	int16_t voice_data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	if (((AudioSynthWavetablePoly<N>*)context)->voices[item].render(voice_data) == false) return;
+	if (!out.audible) {
+		for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) out.sum[j] = voice_data[j];
+		out.audible = true;
+	} else {
+		for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) out.sum[j] += voice_data[j];
+	}
+}
+#endif
+
+template <int N>
+void AudioSynthWavetablePoly<N>::update(void) {
+	int32_t sum[AUDIO_BLOCK_SAMPLES];
+	int16_t voice_data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	bool silent = true;
+
+#ifdef HOST_BUILD
+	if (render_pool && render_pool->threads() > 1) {
+		render_pool->run(N, render_voice, this);
+		for (int w = 0; w < render_pool->threads(); ++w) {
+			const WavetableRenderPool::accumulator& out = render_pool->worker(w);
+			if (!out.audible) continue;
+			if (silent) {
+				for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) sum[j] = out.sum[j];
+				silent = false;
+			} else {
+				for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) sum[j] += out.sum[j];
+			}
+		}
+	} else
+#endif
+	for (int i = 0; i < N; ++i) {
+		// idle voices still take their queued events here
+		if (voices[i].render(voice_data) == false) continue;
+		if (silent) {
+			for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) sum[j] = voice_data[j];
+			silent = false;
+		} else {
+			for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) sum[j] += voice_data[j];
+		}
+	}
+	if (silent) return;
+
+	audio_block_t* block = allocate();
+	if (block == NULL) return;
+	for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) {
+		int32_t v = ((int64_t)sum[j] * multiplier) >> 16;
+		block->data[j] = v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v;
+	}
+	transmit(block);
+	release(block);
+}
@@ -0,0 +1,985 @@
+/*
+ * Host regression tests for AudioSynthWavetable. Built and run by ctest
+ * from the top-level CMakeLists.txt; see host/ for the Teensy stand-ins.
+ */
+
+#include <AudioPlayMidiFile.h>
+#include <AudioSynthWavetable.h>
+#include <AudioSynthWavetablePoly.h>
+#include <WavetableVoiceManager.h>
+#include <wavetable_kernels.h>
+#include "../../host/instruments.h"
+#include "../../host/score_compiler.h"
+#include <thread>
+#include <vector>
+
+// Keeps every block a single voice transmits.
+class Capture : public AudioStream
+{
+public:
+	Capture(void) : AudioStream(1, inputQueueArray) {}
+	virtual void update(void) {
+		audio_block_t *block = receiveReadOnly(0);
+		for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i)
+			samples.push_back(block ? block->data[i] : 0);
+		if (block) release(block);
+	}
+	std::vector<int16_t> samples;
+private:
+	audio_block_t *inputQueueArray[1];
+};
+
+static int passed = 0;
+static int total = 0;
+
+static void check(bool ok, const char* name) {
+	printf("%-40s %s\n", name, ok ? "Passed!" : "Failed...");
+	passed += ok;
+	total++;
+}
+
+static std::vector<int16_t> render_note(AudioSynthWavetable& voice, Capture& out,
+	const instrument_data& instrument, int note, int blocks, int release_block = -1)
+{
+	out.samples.clear();
+	voice.setInstrument(instrument);
+	voice.amplitude(1.0);
+	voice.playNote(note, 100);
+	for (int b = 0; b < blocks; ++b) {
+		if (b == release_block) voice.stop();
+		AudioStream::update_all();
+	}
+	return out.samples;
+}
+
+// The same note on a freshly reset voice must render identically.
+static void test_deterministic(AudioSynthWavetable& voice, Capture& out) {
+	std::vector<int16_t> a = render_note(voice, out, *find_host_instrument("Viola"), 60, 200, 150);
+	std::vector<int16_t> b = render_note(voice, out, *find_host_instrument("Viola"), 60, 200, 150);
+	check(a == b, "deterministic render");
+	bool audible = false;
+	for (size_t i = 0; i < a.size(); ++i) audible |= a[i] != 0;
+	check(audible, "note is audible");
+}
+
+// Envelope stages must last as long as the sample data says (cf. Unit_Main ENV).
+static void test_envelope(AudioSynthWavetable& voice, Capture& out) {
+	const instrument_data& viola = *find_host_instrument("Viola");
+	const int note = 60;
+	voice.setInstrument(viola);
+	const sample_data& s = viola.samples[voice.sampleIndex(note)];
+	const uint32_t expected[] = { 0, s.DELAY_COUNT, s.ATTACK_COUNT, s.HOLD_COUNT, s.DECAY_COUNT, 0, s.RELEASE_COUNT };
+
+	voice.playNote(note, 100);
+	envelopeStateEnum state = voice.getEnvState();
+	int blocks_in_state = 0;
+	bool ok = true;
+	for (int b = 0; b < 20000 && state != STATE_SUSTAIN; ++b) {
+		AudioStream::update_all();
+		++blocks_in_state;
+		if (voice.getEnvState() != state) {
+			int want = (expected[state] * ENVELOPE_PERIOD + AUDIO_BLOCK_SAMPLES - 1) / AUDIO_BLOCK_SAMPLES;
+			if (state != STATE_DELAY && abs(blocks_in_state - want) > 1) ok = false;
+			state = voice.getEnvState();
+			blocks_in_state = 0;
+		}
+	}
+	check(ok && state == STATE_SUSTAIN, "envelope stage durations");
+
+	voice.stop();
+	int blocks = 0;
+	while (voice.isPlaying() && blocks < 20000) {
+		AudioStream::update_all();
+		++blocks;
+	}
+	int want = (expected[STATE_RELEASE] * ENVELOPE_PERIOD) / AUDIO_BLOCK_SAMPLES + 1;
+	check(!voice.isPlaying() && abs(blocks - want) <= 1, "release returns voice to idle");
+}
+
+// The note table, whether decoded (Saw) or built on first use (the older
+// examples), must pick the sample the note ranges do, and clamp stray notes,
+// even while several threads build the tables at once.
+static void test_note_table(void) {
+	AudioSynthWavetable voice;
+	bool ok = find_host_instrument("Saw")->note_samples != NULL && find_host_instrument("Viola")->note_samples == NULL;
+	std::atomic<bool> built(true);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 3; ++t) {
+		threads.push_back(std::thread([&built]() {
+			for (int i = 0; i < host_instrument_count; ++i) {
+				const instrument_data& instrument = *host_instruments[i].instrument;
+				if (instrument.velocity_bands != NULL) continue;
+				for (int note = 0; note < NOTE_COUNT; ++note) {
+					if (AudioSynthWavetable::sampleIndex(instrument, note, 100) != AudioSynthWavetable::scanNoteRanges(instrument, note))
+						built = false;
+				}
+			}
+		}));
+	}
+	for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+	ok = ok && built;
+	for (int i = 0; i < host_instrument_count; ++i) {
+		const instrument_data& instrument = *host_instruments[i].instrument;
+		if (instrument.velocity_bands != NULL)
+			continue;
+		voice.setInstrument(instrument);
+		for (int note = 0; note < NOTE_COUNT; ++note) {
+			int expected;
+			for (expected = 0; expected < instrument.sample_count - 1 && note > instrument.sample_note_ranges[expected]; expected++);
+			ok = ok && voice.sampleIndex(note) == expected;
+		}
+		ok = ok && voice.sampleIndex(-5) == voice.sampleIndex(0) && voice.sampleIndex(500) == voice.sampleIndex(127);
+	}
+	check(ok, "note table matches note ranges");
+}
+
+// A layered instrument must pick its zone by key and velocity, clamping
+// stray velocities, and sound the soft layer for a quiet note.
+static void test_velocity_layers(void) {
+	const instrument_data& layers = *find_host_instrument("SawLayers");
+	AudioSynthWavetable voice;
+	voice.setInstrument(layers);
+	bool ok = layers.velocity_band_count == 2;
+	for (int note = 0; note < NOTE_COUNT; ++note)
+		for (int velocity = 0; velocity <= 127; ++velocity)
+			ok = ok && voice.sampleIndex(note, velocity) == (note > 71 ? 2 : velocity > 63 ? 1 : 0);
+	ok = ok && voice.sampleIndex(60, -3) == 0 && voice.sampleIndex(60, 300) == 1 && voice.sampleIndex(60) == 1;
+	check(ok, "velocity layers pick zone");
+
+	AudioSynthWavetable soft, bright;
+	int16_t soft_data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	int16_t bright_data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	soft.setInstrument(layers);
+	bright.setInstrument(layers);
+	soft.playNote(60, 40);
+	bright.playNote(60, 100);
+	bool differ = false;
+	for (int b = 0; b < 8; ++b) {
+		soft.render(soft_data);
+		bright.render(bright_data);
+		// scale the soft note up to the loud one's level, so only the shapes differ
+		for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i)
+			differ = differ || abs(soft_data[i] * 100 / 40 - bright_data[i]) > 1000;
+	}
+	check(differ, "soft velocity plays soft layer");
+}
+
+// The compile-time equal temperament must match noteToFreq(), tuningTable()
+// must rebuild it, and a loaded table must retune playNote().
+static void test_tuning(void) {
+	bool ok = true;
+	uint32_t table[NOTE_COUNT], shifted[NOTE_COUNT];
+	const float zero[12] = { 0 };
+	AudioSynthWavetable::tuningTable(table, zero);
+	for (int note = 0; note < NOTE_COUNT; ++note) {
+		double freq = AudioSynthWavetable::equal_temperament[note] / 65536.0;
+		ok = ok && fabs(freq / AudioSynthWavetable::noteToFreq(note) - 1) < 1e-5;
+		ok = ok && abs((int)(table[note] - AudioSynthWavetable::equal_temperament[note])) <= 1;
+		shifted[note] = AudioSynthWavetable::equal_temperament[note < NOTE_COUNT - 1 ? note + 1 : note];
+	}
+	check(ok, "tuning tables match equal temperament");
+
+	const instrument_data& saw = *find_host_instrument("Saw");
+	AudioSynthWavetable tuned, plain;
+	int16_t tuned_data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	int16_t plain_data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	tuned.setInstrument(saw);
+	plain.setInstrument(saw);
+	tuned.setTuning(shifted);
+	tuned.playNote(60);
+	plain.playNote(61);
+	ok = true;
+	for (int b = 0; b < 16; ++b) {
+		tuned.render(tuned_data);
+		plain.render(plain_data);
+		ok = ok && memcmp(tuned_data, plain_data, sizeof(plain_data)) == 0;
+	}
+	tuned.setTuning(NULL);
+	check(ok && tuned.getTuning() == AudioSynthWavetable::equal_temperament, "loaded tuning retunes notes");
+}
+
+// Events posted from several threads at once must each arrive exactly once,
+// in the order each thread posted them.
+static void test_event_queue(void) {
+	const int producers = 3, per_producer = 20000;
+	WavetableEventQueue queue;
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p) {
+		threads.push_back(std::thread([&queue, p]() {
+			for (uint32_t i = 0; i < per_producer; ++i) {
+				wavetable_event event = wavetable_event();
+				event.type = EVENT_NOTE;
+				event.amplitude = p;
+				event.note.tone_incr = i;
+				while (!queue.push(event)) std::this_thread::yield();
+			}
+		}));
+	}
+	uint32_t next[producers] = { 0 };
+	bool ok = true;
+	for (int received = 0; received < producers * per_producer; ) {
+		wavetable_event event;
+		if (!queue.pop(event)) {
+			std::this_thread::yield();
+			continue;
+		}
+		ok = ok && event.amplitude < producers && event.note.tone_incr == next[event.amplitude]++;
+		++received;
+	}
+	for (size_t p = 0; p < threads.size(); ++p) threads[p].join();
+	wavetable_event event;
+	check(ok && !queue.pop(event), "event queue delivers every event in order");
+}
+
+// A voice plays its events at the next block, counts a queued note as
+// playing, and drops (and counts) what overflows its queue.
+static void test_voice_events(void) {
+	AudioSynthWavetable voice;
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.stop(); // nothing to stop
+	voice.playNote(60); // no instrument yet
+	bool ok = !voice.isPlaying() && !voice.render(data);
+
+	voice.setInstrument(*find_host_instrument("Saw"));
+	voice.playNote(60);
+	ok = ok && voice.isPlaying() && voice.getEnvState() == STATE_DELAY;
+	voice.render(data);
+	ok = ok && voice.isPlaying() && voice.getEnvState() == STATE_ATTACK;
+
+	for (int i = 0; i < WAVETABLE_EVENT_QUEUE_SIZE + 2; ++i) voice.amplitude(0.5);
+	voice.stop();
+	ok = ok && voice.droppedEvents() == 3;
+	voice.render(data);
+	ok = ok && voice.isPlaying() && voice.getEnvState() != STATE_RELEASE;
+
+	// a note stopped before its first block releases from silence, so idles
+	voice.playNote(62);
+	voice.stop();
+	ok = ok && voice.isPlaying();
+	voice.render(data);
+	ok = ok && !voice.isPlaying();
+
+	// a new instrument cuts the note off at the next block
+	voice.playNote(62);
+	voice.render(data);
+	voice.setInstrument(*find_host_instrument("Saw"));
+	ok = ok && voice.isPlaying() && !voice.render(data) && !voice.isPlaying();
+	check(ok, "voice events apply at the next block");
+}
+
+// The render loop specialized for a sample's features must give the same
+// output as the generic one, with both LFOs, for every instrument.
+static void test_render_variants(void) {
+	bool ok = AudioSynthWavetable::renderVariant(find_host_instrument("RoomKick")->samples[0]) == 0
+		&& AudioSynthWavetable::renderVariant(find_host_instrument("Viola")->samples[0]) == (RENDER_LOOP | RENDER_MODULATION);
+	for (int i = 0; i < host_instrument_count; ++i) {
+		std::vector<int16_t> out[2];
+		for (int specialized = 0; specialized < 2; ++specialized) {
+			AudioSynthWavetable::specializeRender(specialized);
+			AudioSynthWavetable voice;
+			int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+			voice.setInstrument(*host_instruments[i].instrument);
+			for (int b = 0; b < 400; ++b) {
+				if (b % 100 == 0) voice.playNote(40 + b / 10, 100);
+				else if (b % 100 == 70) voice.stop();
+				if (!voice.render(data)) memset(data, 0, sizeof(data));
+				out[specialized].insert(out[specialized].end(), data, data + AUDIO_BLOCK_SAMPLES);
+			}
+		}
+		ok = ok && out[0] == out[1];
+	}
+	AudioSynthWavetable::specializeRender(true);
+	check(ok, "specialized render matches generic");
+
+	// notes at the sample's root pitch and an octave above render by copying
+	const char* names[] = { "Saw", "SawMip" };
+	ok = true;
+	for (int i = 0; i < 2; ++i) {
+		const instrument_data& inst = *find_host_instrument(names[i]);
+		float root = (0x80000000u >> (inst.samples[0].INDEX_BITS - 1)) / inst.samples[0].PER_HERTZ_PHASE_INCREMENT;
+		std::vector<int16_t> out[2];
+		for (int specialized = 0; specialized < 2; ++specialized) {
+			AudioSynthWavetable::specializeRender(specialized);
+			AudioSynthWavetable voice;
+			int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+			voice.setInstrument(inst);
+			for (int b = 0; b < 200; ++b) {
+				if (b % 100 == 0) voice.playFrequency(root * (1 + b / 100), 100);
+				else if (b % 100 == 70) voice.stop();
+				if (!voice.render(data)) memset(data, 0, sizeof(data));
+				out[specialized].insert(out[specialized].end(), data, data + AUDIO_BLOCK_SAMPLES);
+			}
+		}
+		ok = ok && out[0] == out[1];
+	}
+	AudioSynthWavetable::specializeRender(true);
+	check(ok, "exact-ratio copy matches interpolation");
+}
+
+// A pool must mix to exactly the sum of the same notes on standalone voices.
+static void test_poly_matches_voices(void) {
+	const instrument_data& viola = *find_host_instrument("Viola");
+	const int notes[] = { 48, 60, 67 };
+	AudioSynthWavetable single[3];
+	AudioSynthWavetablePoly<4> pool;
+	Capture out;
+	AudioConnection cord(pool, 0, out, 0);
+	for (int i = 0; i < 3; ++i) {
+		single[i].setInstrument(viola);
+		single[i].amplitude(0.3);
+		single[i].playNote(notes[i], 100);
+	}
+	pool.setInstrument(viola);
+	pool.amplitude(0.3);
+	for (int i = 0; i < 3; ++i) pool[i].playNote(notes[i], 100);
+
+	bool ok = pool.activeVoices() == 3;
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	std::vector<int16_t> expected;
+	for (int b = 0; b < 300; ++b) {
+		if (b == 200) {
+			for (int i = 0; i < 3; ++i) single[i].stop();
+			for (int i = 0; i < 3; ++i) pool[i].stop();
+		}
+		int32_t sum[AUDIO_BLOCK_SAMPLES] = { 0 };
+		for (int i = 0; i < 3; ++i)
+			if (single[i].isPlaying() && single[i].render(data))
+				for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) sum[j] += data[j];
+		for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j)
+			expected.push_back(sum[j] > 32767 ? 32767 : sum[j] < -32768 ? -32768 : sum[j]);
+		AudioStream::update_all();
+	}
+	check(ok && out.samples == expected, "poly pool matches standalone voices");
+}
+
+// Spread over worker threads a pool must render every voice exactly once
+// and mix to exactly what it does on one thread.
+static int pool_items[1000];
+static void count_item(void* context, int item, WavetableRenderPool::accumulator& out) {
+	(void)context;
+	(void)out;
+	__atomic_fetch_add(&pool_items[item], 1, __ATOMIC_RELAXED);
+}
+
+static void test_threaded_poly(void) {
+	WavetableRenderPool workers(4);
+	bool ok = workers.threads() == 4;
+	for (int count = 0; count <= 1000; count += 111) {
+		memset(pool_items, 0, sizeof(pool_items));
+		workers.run(count, count_item, NULL);
+		for (int i = 0; i < 1000; ++i) ok = ok && pool_items[i] == (i < count);
+	}
+
+	const instrument_data& viola = *find_host_instrument("Viola");
+	AudioSynthWavetablePoly<96> serial, threaded;
+	Capture serial_out, threaded_out;
+	AudioConnection serial_cord(serial, 0, serial_out, 0), threaded_cord(threaded, 0, threaded_out, 0);
+	threaded.setRenderPool(&workers);
+	AudioSynthWavetablePoly<96>* pools[] = { &serial, &threaded };
+	for (int p = 0; p < 2; ++p) {
+		pools[p]->setInstrument(viola);
+		pools[p]->gain(0.05);
+	}
+	for (int b = 0; b < 400; ++b) {
+		for (int p = 0; p < 2; ++p) {
+			if (b < 96) (*pools[p])[b].playNote(30 + b * 7 % 60, 40 + b % 80);
+			if (b >= 200 && b < 296) (*pools[p])[b - 200].stop();
+		}
+		AudioStream::update_all();
+	}
+	check(ok && serial_out.samples.size() == 400 * AUDIO_BLOCK_SAMPLES && threaded_out.samples == serial_out.samples,
+		"threaded pool matches serial render");
+}
+
+// Records each MIDI event with the sample it falls on.
+class MidiLog : public MidiSink
+{
+public:
+	virtual void noteOn(uint8_t channel, uint8_t note, uint8_t velocity, int offset) {
+		events.push_back({ block + offset, channel, note, velocity });
+	}
+	virtual void noteOff(uint8_t channel, uint8_t note, int offset) {
+		events.push_back({ block + offset, channel, note, 0 });
+	}
+	struct event { uint32_t sample; int channel, note, velocity; };
+	std::vector<event> events;
+	uint32_t block = 0;
+};
+
+// A type 1 file whose tempo doubles at tick 96.
+static const uint8_t test_song[] = {
+	'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, 2, 0, 96,
+	'M', 'T', 'r', 'k', 0, 0, 0, 18,
+	0x00, 0xFF, 0x51, 3, 0x07, 0xA1, 0x20,  // 500000 us per quarter
+	0x60, 0xFF, 0x51, 3, 0x03, 0xD0, 0x90,  // tick 96: 250000 us
+	0x00, 0xFF, 0x2F, 0,
+	'M', 'T', 'r', 'k', 0, 0, 0, 28,
+	0x00, 0x90, 60, 100,                    // tick 0
+	0x30, 62, 0,                            // tick 48, running status note-off
+	0x00, 0xC1, 5,
+	0x00, 0xF0, 2, 0x01, 0xF7,              // sysex, skipped
+	0x81, 0x10, 0x91, 64, 90,               // tick 192
+	0x30, 0x81, 64, 0,                      // tick 240
+	0x00, 0xFF, 0x2F, 0,
+};
+
+// Each event must reach the sink in the block it falls in, at its offset,
+// in time order across tracks.
+static void test_midi_file(void) {
+	MidiMemorySource source(test_song, sizeof(test_song));
+	MidiLog log;
+	AudioPlayMidiFile player;
+	bool ok = player.play(source, log);
+	for (int b = 0; b < 1000 && player.isPlaying(); ++b, log.block += AUDIO_BLOCK_SAMPLES) player.playBlock();
+
+	const double slow = AUDIO_SAMPLE_RATE_EXACT * 0.5 / 96, fast = slow / 2;
+	const MidiLog::event want[] = {
+		{ 0, 0, 60, 100 }, { (uint32_t)(48 * slow), 0, 62, 0 },
+		{ (uint32_t)(96 * slow + 96 * fast), 1, 64, 90 }, { (uint32_t)(96 * slow + 144 * fast), 1, 64, 0 },
+	};
+	ok = ok && log.events.size() == 4 && !player.isPlaying();
+	for (int i = 0; ok && i < 4; ++i) {
+		const MidiLog::event& e = log.events[i];
+		ok = abs((int)e.sample - (int)want[i].sample) <= 1 && e.channel == want[i].channel
+			&& e.note == want[i].note && e.velocity == want[i].velocity;
+	}
+	check(ok, "MIDI file events land on their samples");
+
+	// the wavetable sink takes a free voice per note and frees it by channel and note
+	AudioSynthWavetablePoly<2> pool;
+	WavetableMidiSink<2> sink(pool);
+	sink.setInstrument(0, find_host_instrument("Viola"));
+	sink.noteOn(0, 60, 100, 0);
+	sink.noteOn(0, 64, 100, 0);
+	sink.noteOn(1, 67, 100, 0);  // no instrument on channel 1
+	ok = pool.activeVoices() == 2;
+	pool.update();
+	sink.noteOff(0, 64, 0);
+	pool.update();
+	ok = ok && pool[0].isPlaying() && pool[1].getEnvState() == STATE_RELEASE;
+	check(ok, "MIDI sink allocates and releases voices");
+}
+
+// A compiled score must play exactly like the file it was compiled from,
+// and a Playtune score must read as notes on its tone generators.
+static void test_compiled_score(void) {
+	std::vector<score_note_event> notes;
+	MidiMemorySource source(test_song, sizeof(test_song));
+	compiled_score score;
+	bool ok = read_midi_score(source, notes) && compile_score(notes, 8, score);
+
+	const instrument_data* viola = find_host_instrument("Viola");
+	const instrument_data* slots[] = { viola, viola };  // channel 1's program change takes a slot
+	AudioPlayScore player;
+	AudioPlayMidiFile midi;
+	AudioSynthWavetablePoly<8> compiled_pool, midi_pool;
+	Capture compiled_out, midi_out;
+	AudioConnection compiled_cord(compiled_pool, 0, compiled_out, 0), midi_cord(midi_pool, 0, midi_out, 0);
+	WavetableMidiSink<8> sink(midi_pool);
+	for (int c = 0; c < MIDI_CHANNELS; ++c) sink.setInstrument(c, viola);
+	ok = ok && score.slot_programs.size() == 2 && player.play(score.events.data(), score.events.size(), &compiled_pool[0], 8, slots, 2);
+	ok = ok && midi.play(source, sink);
+	for (int b = 0; b < 400; ++b) AudioStream::update_all();
+	check(ok && !player.isPlaying() && compiled_out.samples == midi_out.samples, "compiled score matches MIDI file");
+
+	notes.clear();
+	ok = read_playtune_score("const unsigned char score[] = { 0xC1,48, 0x91,60,100, 0,100, 0x91,64,90, 0,50, 0x81, 0xf0 };",
+		true, notes) && notes.size() == 5;
+	uint32_t ms100 = 100 * AUDIO_SAMPLE_RATE_EXACT / 1000, ms150 = 150 * AUDIO_SAMPLE_RATE_EXACT / 1000;
+	ok = ok && notes[0].kind == SCORE_PROGRAM && notes[0].note == 48
+		&& notes[1].kind == SCORE_NOTE_ON && notes[1].sample == 0 && notes[1].note == 60 && notes[1].velocity == 100
+		&& notes[2].kind == SCORE_NOTE_OFF && notes[2].sample == ms100 && notes[2].note == 60
+		&& notes[3].kind == SCORE_NOTE_ON && notes[3].sample == ms100 && notes[3].channel == 1
+		&& notes[4].kind == SCORE_NOTE_OFF && notes[4].sample == ms150 && notes[4].note == 64;
+	check(ok, "Playtune score reads as channel notes");
+}
+
+// A note played and stopped at an offset into the block must sound exactly
+// like the same note on a block boundary, delayed by the offset, and the
+// note it replaces must play on up to that offset.
+static void test_note_offsets(void) {
+	const instrument_data& saw = *find_host_instrument("Saw");
+	const int offset = 40; // a whole number of envelope periods
+	AudioSynthWavetable on_block, on_offset;
+	on_block.setInstrument(saw);
+	on_offset.setInstrument(saw);
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	std::vector<int16_t> a, b;
+	for (int block = 0; block < 60; ++block) {
+		if (block == 0) {
+			on_block.playNote(60, 100);
+			on_offset.playNote(60, 100, offset);
+		}
+		if (block == 30) {
+			on_block.stop();
+			on_offset.stop(offset);
+		}
+		memset(data, 0, sizeof(data));
+		on_block.render(data);
+		a.insert(a.end(), data, data + AUDIO_BLOCK_SAMPLES);
+		memset(data, 0, sizeof(data));
+		on_offset.render(data);
+		b.insert(b.end(), data, data + AUDIO_BLOCK_SAMPLES);
+	}
+	bool ok = true;
+	for (int i = 0; i < offset; ++i) ok = ok && b[i] == 0;
+	for (size_t i = 0; i + offset < b.size(); ++i) ok = ok && b[i + offset] == a[i];
+
+	// a retriggered voice plays its old note up to the offset
+	on_block.playNote(48, 100);
+	on_offset.playNote(48, 100);
+	for (int block = 0; block < 4; ++block) {
+		on_block.render(data);
+		on_offset.render(data);
+	}
+	int16_t old_note[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	on_block.render(old_note);
+	on_offset.playNote(72, 100, offset);
+	ok = ok && on_offset.render(data) && memcmp(data, old_note, offset * sizeof(int16_t)) == 0
+		&& memcmp(data + offset, old_note + offset, (AUDIO_BLOCK_SAMPLES - offset) * sizeof(int16_t)) != 0;
+	check(ok, "notes start and stop at their offsets");
+}
+
+// The voice manager must hand out free voices first, then releasing ones,
+// then steal by its policy, and find every held note's voice.
+static void test_voice_manager(void) {
+	AudioSynthWavetablePoly<4> pool;
+	WavetableVoiceManager<4> manager(&pool[0]);
+	manager.setInstrument(0, find_host_instrument("Saw"));
+	manager.setInstrument(1, find_host_instrument("Saw"));
+	bool ok = manager.noteOn(2, 60, 100) == -1; // no instrument
+	const int velocities[] = { 100, 20, 80, 60 };
+	for (int i = 0; i < 4; ++i) ok = ok && manager.noteOn(0, 60 + i, velocities[i]) == i;
+	ok = ok && manager.freeVoices() == 0 && manager.heldVoices() == 4 && manager.findVoice(0, 62) == 2;
+
+	// oldest: the first note's voice
+	ok = ok && manager.noteOn(0, 70, 90) == 0 && manager.findVoice(0, 60) == -1 && manager.steals() == 1;
+	// softest: the velocity 20 note
+	manager.setStealPolicy(STEAL_SOFTEST);
+	ok = ok && manager.noteOn(0, 71, 90) == 1 && manager.findVoice(0, 61) == -1;
+	// lowest priority: channel 1 loses its voice although channel 0's are older
+	manager.setStealPolicy(STEAL_LOWEST_PRIORITY);
+	manager.setChannelPriority(0, 10);
+	ok = ok && manager.noteOn(1, 72, 90) == 2 && manager.noteOn(1, 73, 90) == 2 && manager.findVoice(1, 72) == -1;
+
+	// a released voice is taken before any held one, and a retriggered note
+	// keeps its voice
+	ok = ok && manager.noteOff(0, 70) == 0 && manager.noteOff(0, 70) == -1 && manager.releasingVoices() == 1;
+	ok = ok && manager.noteOn(0, 70, 90) == 0 && manager.heldVoices() == 4;
+	ok = ok && manager.noteOff(0, 71) == 1 && manager.noteOn(0, 74, 90) == 1 && manager.steals() == 5;
+
+	// once a release ends the voice is free again, without stealing
+	manager.noteOff(0, 74);
+	for (int b = 0; b < 2000 && pool[1].isPlaying(); ++b) pool.update();
+	ok = ok && !pool[1].isPlaying() && manager.noteOn(0, 75, 90) == 1 && manager.steals() == 5;
+	manager.allNotesOff();
+	ok = ok && manager.heldVoices() == 0 && manager.releasingVoices() == 4;
+
+	// a velocity past 127, as from a malformed file, plays in the loudest band
+	AudioSynthWavetablePoly<2> pair;
+	WavetableVoiceManager<2> clamped(&pair[0]);
+	clamped.setInstrument(0, find_host_instrument("Saw"));
+	clamped.setStealPolicy(STEAL_SOFTEST);
+	ok = ok && clamped.noteOn(0, 60, 200) == 0 && clamped.noteOn(0, 61, 200) == 1;
+	ok = ok && clamped.noteOn(0, 62, 10) == 0 && clamped.noteOn(0, 63, 10) == 0;
+	ok = ok && clamped.findVoice(0, 61) == 1 && clamped.heldVoices() == 2;
+	check(ok, "voice manager allocates and steals");
+}
+
+// Counts the voices render() reports idle.
+struct IdleLog : WavetableIdleListener {
+	int count = 0, last = -1;
+	void voiceIdle(int id) { ++count; last = id; }
+};
+
+// A voice reports going idle once per note, even a note cut off before it
+// rendered a block, and the manager frees it without polling.
+static void test_idle_notification(void) {
+	AudioSynthWavetable voice;
+	IdleLog log;
+	voice.setIdleListener(&log, 7);
+	voice.setInstrument(*find_host_instrument("Saw"));
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.playNote(60, 100);
+	voice.stop();
+	for (int b = 0; b < 2000 && voice.isPlaying(); ++b) voice.render(data);
+	bool ok = log.count == 1 && log.last == 7;
+	voice.playNote(60, 100, 10);
+	voice.amplitude(0.5);
+	voice.render(data);
+	ok = ok && log.count == 1;
+	voice.stop(20);
+	for (int b = 0; b < 2000 && voice.isPlaying(); ++b) voice.render(data);
+	ok = ok && log.count == 2;
+	for (int b = 0; b < 10; ++b) voice.render(data);
+	ok = ok && log.count == 2;
+
+	AudioSynthWavetablePoly<2> pool;
+	WavetableVoiceManager<2> manager(&pool[0]);
+	manager.setInstrument(0, find_host_instrument("Saw"));
+	manager.noteOn(0, 60, 100);
+	manager.noteOn(0, 61, 100);
+	manager.noteOff(0, 60);
+	for (int b = 0; b < 2000 && pool[0].isPlaying(); ++b) pool.update();
+	ok = ok && manager.freeVoices() == 0 && manager.reclaimFinished() == 1 && manager.freeVoices() == 1;
+	ok = ok && manager.noteOn(0, 62, 100) == 0 && manager.steals() == 0;
+	check(ok, "idle voices notify their listener");
+}
+
+// An idle voice drops out of update_all() and any event brings it back, with
+// the same output as a voice updated every block.
+static void test_idle_parking(AudioSynthWavetable& voice, Capture& out) {
+	const instrument_data& saw = *find_host_instrument("Saw");
+	AudioSynthWavetable::parkIdle(false);
+	std::vector<int16_t> a = render_note(voice, out, saw, 60, 2000, 20);
+	AudioSynthWavetable::parkIdle(true);
+	std::vector<int16_t> b = render_note(voice, out, saw, 60, 2000, 20);
+	bool ok = a == b && !voice.isPlaying() && !voice.isActive();
+	voice.playNote(60, 100, 64);
+	ok = ok && voice.isActive();
+	AudioStream::update_all();
+	ok = ok && voice.isActive() && voice.isPlaying();
+	voice.stop();
+	voice.amplitude(0.0);
+	for (int i = 0; i < 2000 && voice.isPlaying(); ++i) AudioStream::update_all();
+	AudioStream::update_all();
+	ok = ok && !voice.isActive();
+	voice.amplitude(1.0);
+	ok = ok && voice.isActive();
+	AudioStream::update_all();
+	ok = ok && !voice.isActive();
+	check(ok, "idle voices leave the update list");
+}
+
+// A stolen note fades out under the new one for QUICK_KILL_PERIODS, and the
+// new note sounds from its offset exactly as on an idle voice.
+static void test_quick_kill(void) {
+	const instrument_data& saw = *find_host_instrument("Saw");
+	const int offset = 24, fade = QUICK_KILL_PERIODS * ENVELOPE_PERIOD;
+	AudioSynthWavetable stolen, fresh;
+	stolen.setInstrument(saw);
+	fresh.setInstrument(saw);
+	stolen.playNote(48, 60);
+	int16_t a[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4))), b[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	for (int i = 0; i < 40; ++i) stolen.render(a);
+	stolen.stealNote(55, 60, offset);
+	fresh.playNote(55, 60, offset);
+	bool ok = true, faded = false;
+	for (int block = 0; block < 4; ++block) {
+		memset(b, 0, sizeof(b));
+		stolen.render(a);
+		fresh.render(b);
+		for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) {
+			int t = block * AUDIO_BLOCK_SAMPLES + i;
+			if (t < offset) continue;
+			if (t >= offset + fade) ok = ok && a[i] == b[i];
+			else faded |= a[i] != b[i];
+		}
+	}
+	check(ok && faded, "stolen notes fade out under the new one");
+}
+
+// Over its load budget the manager fades out the voices the budget cannot
+// pay for, oldest first, then steals or refuses new notes until the load
+// drops; the cost here is a simulated 1000 per sounding voice.
+static void test_load_limit(void) {
+	AudioSynthWavetablePoly<8> pool;
+	WavetableVoiceManager<8> manager(&pool[0]);
+	manager.setInstrument(0, find_host_instrument("Saw"));
+	manager.setLoadBudget(4000);
+	for (int i = 0; i < 8; ++i) manager.noteOn(0, 60 + i, 100);
+	manager.limitLoad(8000);
+	bool ok = manager.voiceLimit() == 4 && manager.heldVoices() == 4 && manager.fadingVoices() == 4
+		&& manager.findVoice(0, 60) == -1 && manager.findVoice(0, 64) == 4 && manager.overloads() == 1 && manager.shedVoices() == 4;
+	// still over budget before the fade ends: the voices fading out are not shed again
+	manager.limitLoad(8000);
+	ok = ok && manager.voiceLimit() == 4 && manager.heldVoices() == 4 && manager.shedVoices() == 4;
+	for (int b = 0; b < 4; ++b) {
+		pool.update();
+		manager.limitLoad(1000 * pool.activeVoices());
+	}
+	ok = ok && manager.fadingVoices() == 0 && manager.freeVoices() == 4 && manager.voiceLimit() == 4;
+
+	manager.setOverloadPolicy(OVERLOAD_REFUSE);
+	ok = ok && manager.noteOn(0, 70, 100) == -1 && manager.refusedNotes() == 1;
+	manager.setOverloadPolicy(OVERLOAD_STEAL);
+	ok = ok && manager.noteOn(0, 70, 100) == 4 && manager.heldVoices() == 4 && manager.steals() == 1;
+	manager.limitLoad(2000);
+	ok = ok && manager.voiceLimit() == 5 && manager.noteOn(0, 71, 100) >= 0 && manager.heldVoices() == 5;
+	check(ok, "load limit sheds and refuses voices");
+}
+
+// Every vector kernel must render looped and one-shot notes bit-identically to the scalar one.
+static void test_kernels_match_scalar(AudioSynthWavetable& voice, Capture& out) {
+	const char* names[] = { "Viola", "Ocarina", "RoomKick", "Explosion" };
+	wavetableKernelEnum initial = wavetable_selected_kernel();
+	bool ok = true;
+	for (int k = KERNEL_SCALAR + 1; k < KERNEL_COUNT; ++k) {
+		if (!wavetable_kernel_supported((wavetableKernelEnum)k)) continue;
+		for (int i = 0; i < 4; ++i) {
+			const instrument_data& instrument = *find_host_instrument(names[i]);
+			for (int note = 40; note < 100; note += 13) {
+				wavetable_select_kernel(KERNEL_SCALAR);
+				std::vector<int16_t> a = render_note(voice, out, instrument, note, 150, 100);
+				wavetable_select_kernel((wavetableKernelEnum)k);
+				std::vector<int16_t> b = render_note(voice, out, instrument, note, 150, 100);
+				ok = ok && a == b;
+			}
+		}
+	}
+	wavetable_select_kernel(initial);
+	check(ok, "vector kernels match scalar");
+}
+
+// Every mode passes samples through at whole-sample steps (linear weighs the
+// sample by 0xFFFF/0x10000, so it may be 1 LSB low), and higher-order modes
+// track a pitched-down tone more closely.
+static void test_interpolation_modes(void) {
+	const int bits = 12, length = 1 << bits;
+	std::vector<int16_t> sample(length);
+	for (int i = 0; i < length; ++i) sample[i] = 20000 * sin(2 * M_PI * 0.19 * i);
+
+	int16_t out[INTERPOLATION_COUNT][256];
+	bool ok = true;
+	for (int m = 0; m < INTERPOLATION_COUNT; ++m) {
+		wavetable_interpolate_mode((interpolationModeEnum)m, out[m], 256, 0, 1u << (32 - bits), &sample[0], length, bits, 0x10000);
+		for (int i = 0; i < 256; ++i)
+			ok = ok && abs(out[m][i] - sample[i]) <= (m == INTERPOLATION_LINEAR ? 1 : 0);
+	}
+	check(ok, "modes are exact at whole-sample steps");
+
+	const uint32_t incr = 0.6180 * (1u << (32 - bits));
+	double last_error = 1e30;
+	ok = true;
+	for (int m = 0; m < INTERPOLATION_COUNT; ++m) {
+		wavetable_interpolate_mode((interpolationModeEnum)m, out[m], 256, 8u << (32 - bits), incr, &sample[0], length, bits, 0x10000);
+		double error = 0;
+		for (int i = 0; i < 256; ++i) {
+			double pos = 8 + (double)i * incr / (1u << (32 - bits));
+			double e = out[m][i] - 20000 * sin(2 * M_PI * 0.19 * pos);
+			error += e * e;
+		}
+		ok = ok && error < last_error;
+		last_error = error;
+	}
+	check(ok, "higher-order modes reduce error");
+}
+
+// Samples padded with silent guard samples must render exactly as the
+// bounds-checked path does on the same data, right up to both ends.
+static void test_guard_samples(void) {
+	const int bits = 10, length = 1 << bits;
+	std::vector<int16_t> padded(length + 2 * WAVETABLE_GUARD_SAMPLES, 0);
+	const int16_t* sample = &padded[WAVETABLE_GUARD_SAMPLES];
+	for (int i = 0; i < length; ++i) padded[WAVETABLE_GUARD_SAMPLES + i] = (i * 7919) % 40000 - 20000;
+
+	const uint32_t incr = 0.7071 * (1u << (32 - bits));
+	const int count = ((uint32_t)(length - 1) << (32 - bits)) / incr;
+	std::vector<int16_t> checked(count), guarded(count);
+	bool ok = true;
+	for (int m = 0; m < INTERPOLATION_COUNT; ++m) {
+		wavetable_interpolate_mode((interpolationModeEnum)m, &checked[0], count, 0, incr, sample, length, bits, 0x8000);
+		wavetable_interpolate_mode((interpolationModeEnum)m, &guarded[0], count, 0, incr, sample, WAVETABLE_GUARDED, bits, 0x8000);
+		ok = ok && checked == guarded;
+	}
+	check(ok, "guarded reads match bounds-checked reads");
+}
+
+// The exact-ratio copy must match interpolating at whole-sample steps, for
+// every kernel, mode and step.
+static void test_copy_kernels(void) {
+	const int bits = 10, length = 1 << bits;
+	std::vector<int16_t> sample(length + 2 * WAVETABLE_GUARD_SAMPLES);
+	for (size_t i = 0; i < sample.size(); ++i) sample[i] = (i * 7919) % 60000 - 30000;
+	const int16_t* data = &sample[WAVETABLE_GUARD_SAMPLES];
+	const int count = 203;
+	wavetableKernelEnum initial = wavetable_selected_kernel();
+	bool ok = wavetable_exact_ratio(3u << (32 - bits), 2u << (32 - bits), bits)
+		&& !wavetable_exact_ratio(0, (2u << (32 - bits)) + 1, bits);
+	for (int k = 0; k < KERNEL_COUNT; ++k) {
+		if (!wavetable_select_kernel((wavetableKernelEnum)k)) continue;
+		for (int m = 0; m < INTERPOLATION_COUNT; ++m) {
+			for (uint32_t step = 1; step <= 4; ++step) {
+				int16_t expected[count], copied[count];
+				wavetable_interpolate_mode_envelope((interpolationModeEnum)m, expected, count, 5u << (32 - bits), step << (32 - bits),
+					data, WAVETABLE_GUARDED, bits, 0xC000, 1 << 20, UNITY_GAIN / 203);
+				wavetable_copy_envelope(copied, count, 5, step, data, m == INTERPOLATION_LINEAR, 0xC000, 1 << 20, UNITY_GAIN / 203);
+				ok = ok && memcmp(expected, copied, sizeof(copied)) == 0;
+			}
+		}
+		// an octave up that ends on the last sample of an unguarded array
+		// must not load past it
+		int16_t expected[64], copied[64];
+		std::vector<int16_t> exact(data, data + 2 * 64 - 1);
+		wavetable_copy_envelope_scalar(expected, 64, 0, 2, exact.data(), 0, 0xC000, 0, UNITY_GAIN / 64);
+		wavetable_copy_envelope(copied, 64, 0, 2, exact.data(), 0, 0xC000, 0, UNITY_GAIN / 64);
+		ok = ok && memcmp(expected, copied, sizeof(copied)) == 0;
+	}
+	wavetable_select_kernel(initial);
+	check(ok, "copy kernels match interpolation");
+}
+
+// The fused kernels must match interpolating first and applying the envelope
+// ramp in a second pass, for every kernel, mode and shape of ramp.
+static void test_fused_envelope(void) {
+	const int bits = 10, length = 1 << bits;
+	std::vector<int16_t> sample(length + 1);
+	for (int i = 0; i <= length; ++i) sample[i] = (i * 7919) % 60000 - 30000;
+	// attack from silence, decay from full scale, sustain, release to silence
+	const int32_t ramps[][2] = { { 0, UNITY_GAIN / 203 }, { UNITY_GAIN, -(UNITY_GAIN / 2) / 203 },
+		{ UNITY_GAIN - 12345, 0 }, { 1 << 20, -(1 << 20) / 203 } };
+	const uint32_t incr = 1.37 * (1u << (32 - bits));
+	const int count = 203;
+	wavetableKernelEnum initial = wavetable_selected_kernel();
+	bool ok = true;
+	for (int k = 0; k < KERNEL_COUNT; ++k) {
+		if (!wavetable_select_kernel((wavetableKernelEnum)k)) continue;
+		for (int m = 0; m < INTERPOLATION_COUNT; ++m) {
+			for (size_t r = 0; r < sizeof(ramps) / sizeof(ramps[0]); ++r) {
+				int16_t expected[count], fused[count];
+				wavetable_interpolate_mode((interpolationModeEnum)m, expected, count, 0, incr, &sample[0], length + 1, bits, 0xC000);
+				int32_t env_mult = ramps[r][0];
+				for (int i = 0; i < count; ++i) {
+					env_mult += ramps[r][1];
+					expected[i] = signed_multiply_32x16b(env_mult >> 15, expected[i]);
+				}
+				wavetable_interpolate_mode_envelope((interpolationModeEnum)m, fused, count, 0, incr, &sample[0], length + 1, bits, 0xC000,
+					ramps[r][0], ramps[r][1]);
+				ok = ok && memcmp(expected, fused, sizeof(fused)) == 0;
+			}
+		}
+	}
+	wavetable_select_kernel(initial);
+	check(ok, "fused envelope matches two passes");
+}
+
+// A voice in its delay renders nothing, yet starts its attack on time.
+static void test_silent_delay(void) {
+	const instrument_data& pad = *find_host_instrument("SawPad");
+	const int delay = pad.samples[0].DELAY_COUNT * ENVELOPE_PERIOD;
+	AudioSynthWavetable voice;
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.setInstrument(pad);
+	voice.playNote(69, 100);
+	bool ok = true;
+	for (int b = 0; b < delay / AUDIO_BLOCK_SAMPLES; ++b)
+		ok = ok && voice.render(data) == false && voice.getEnvState() == STATE_DELAY;
+	ok = ok && voice.render(data);
+	for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i)
+		ok = ok && (i < delay % AUDIO_BLOCK_SAMPLES ? data[i] == 0 : i < AUDIO_BLOCK_SAMPLES - 8 || data[i] != 0);
+	check(ok, "delay renders nothing, attack on time");
+}
+
+// Counts the blocks 'voice' plays for before going idle by itself, up to 'limit'.
+static int blocks_until_idle(AudioSynthWavetable& voice, int note, int velocity, int limit) {
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.playNote(note, velocity);
+	int blocks = 0;
+	while (voice.isPlaying() && blocks < limit) {
+		voice.render(data);
+		++blocks;
+	}
+	return blocks;
+}
+
+// Voices fading below their idle floor, and one-shots that have played
+// out, must free themselves without a stop().
+static void test_idle_floor(void) {
+	AudioSynthWavetable voice;
+	// a quiet note (about -22 dB) idles after its 5 ms attack under a -20 dB floor
+	voice.setInstrument(*find_host_instrument("Saw"));
+	bool ok = blocks_until_idle(voice, 69, 10, 1000) == 1000;
+	voice.setIdleFloor(-20);
+	int blocks = blocks_until_idle(voice, 69, 10, 1000);
+	ok = ok && blocks > 1 && blocks < 5;
+
+	// a loud one (about -2 dB) decays to -8 dB: it idles during the decay under
+	// a -6 dB floor and holds its sustain under the default floor
+	const instrument_data& pad = *find_host_instrument("SawPad");
+	const sample_data& s = pad.samples[0];
+	const int decay_start = (s.DELAY_COUNT + s.ATTACK_COUNT) * ENVELOPE_PERIOD / AUDIO_BLOCK_SAMPLES;
+	const int decay_end = decay_start + s.DECAY_COUNT * ENVELOPE_PERIOD / AUDIO_BLOCK_SAMPLES;
+	voice.setInstrument(pad);
+	voice.setIdleFloor(-6);
+	blocks = blocks_until_idle(voice, 69, 100, 1000);
+	ok = ok && blocks > decay_start && blocks < decay_end;
+	voice.setIdleFloor(DEFAULT_IDLE_FLOOR);
+	ok = ok && blocks_until_idle(voice, 69, 100, 1000) == 1000;
+
+	// a one-shot idles once it has played out
+	voice.setInstrument(*find_host_instrument("RoomKick"));
+	ok = ok && blocks_until_idle(voice, 60, 100, 10000) < 10000;
+	check(ok, "voices below the idle floor go idle");
+}
+
+// Ratio in dB of the power at the harmonics of f0 to the rest of the power in x.
+static double harmonic_to_alias_db(const std::vector<int16_t>& x, double f0) {
+	double total = 0, harmonic = 0;
+	for (size_t i = 0; i < x.size(); ++i) total += (double)x[i] * x[i];
+	for (int h = 1; h * f0 < AUDIO_SAMPLE_RATE_EXACT / 2; ++h) {
+		double omega = 2 * M_PI * h * f0 / AUDIO_SAMPLE_RATE_EXACT, re = 0, im = 0;
+		for (size_t i = 0; i < x.size(); ++i) {
+			double w = 0.5 - 0.5 * cos(2 * M_PI * i / x.size());
+			re += w * x[i] * cos(omega * i);
+			im += w * x[i] * sin(omega * i);
+		}
+		harmonic += 8 * (re * re + im * im) / x.size();
+	}
+	return 10 * log10(harmonic / (total - harmonic));
+}
+
+// Notes far above the sample's pitch play from the mip levels, which must
+// keep aliasing well below that of the full-rate sample.
+static void test_mip_levels(AudioSynthWavetable& voice, Capture& out) {
+	const instrument_data& saw = *find_host_instrument("Saw");
+	const instrument_data& saw_mip = *find_host_instrument("SawMip");
+	const sample_data& s = saw.samples[0];
+	const int note = 100;
+	// the synthetic saw repeats every 100 samples (host/make_test_instruments.py)
+	uint32_t incr = AudioSynthWavetable::noteToFreq(note) * s.PER_HERTZ_PHASE_INCREMENT;
+	double f0 = (double)incr / (1u << (32 - s.INDEX_BITS)) * AUDIO_SAMPLE_RATE_EXACT / 100;
+
+	std::vector<int16_t> flat = render_note(voice, out, saw, note, 80);
+	std::vector<int16_t> mip = render_note(voice, out, saw_mip, note, 80);
+	flat.erase(flat.begin(), flat.begin() + 16 * AUDIO_BLOCK_SAMPLES);
+	mip.erase(mip.begin(), mip.begin() + 16 * AUDIO_BLOCK_SAMPLES);
+	double flat_db = harmonic_to_alias_db(flat, f0), mip_db = harmonic_to_alias_db(mip, f0);
+	check(mip_db > flat_db + 8 && mip_db > 20, "mip levels reduce aliasing");
+}
+
+int main(void) {
+	AudioMemory(16);
+	AudioSynthWavetable voice;
+	Capture out;
+	AudioConnection cord(voice, 0, out, 0);
+
+	test_deterministic(voice, out);
+	test_envelope(voice, out);
+	test_note_table();
+	test_velocity_layers();
+	test_tuning();
+	test_event_queue();
+	test_voice_events();
+	test_note_offsets();
+	test_render_variants();
+	test_poly_matches_voices();
+	test_threaded_poly();
+	test_voice_manager();
+	test_idle_notification();
+	test_midi_file();
+	test_compiled_score();
+	test_kernels_match_scalar(voice, out);
+	test_interpolation_modes();
+	test_guard_samples();
+	test_fused_envelope();
+	test_copy_kernels();
+	test_silent_delay();
+	test_idle_floor();
+	test_mip_levels(voice, out);
+	test_idle_parking(voice, out);
+	test_quick_kill();
+	test_load_limit();
+
+	printf("%d/%d tests passed\n", passed, total);
+	return passed == total ? 0 : 1;
+}
@@ -293,8 +293,7 @@ void loop() {
     if (current_section != wavetable[0].getEnvState()) {
       int duration = (int)timer_env;
       timer_env = 0;
-      int i;
-      for (i = 0; note > SAMPLES_ENV->sample_note_ranges[i]; i++);
+      int i = wavetable[0].sampleIndex(note);
       Serial.printf("Duration: %dms\n", duration);
       Serial.printf("Expected: %dms\n", (int)ENV_EXPECTED[i][(int)current_section]);
       int error = duration - (int)ENV_EXPECTED[i][(int)current_section];
@@ -0,0 +1,489 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "AudioSynthWavetable.h"
+#include <stdint.h>
+#include <type_traits>
+
+#define VOICE_CHANNELS 16
+#define VOICE_BANDS 8 // velocity bands for STEAL_SOFTEST, 16 velocities each
+
+// Which sounding voice a note takes when no voice is free. A voice in its
+// release is always taken first, the one released longest ago.
+enum voiceStealEnum {
+	STEAL_OLDEST,          // the held voice that started longest ago
+	STEAL_SOFTEST,         // the oldest held voice of the lowest velocity band; this
+	                       // ranks notes by how hard they were struck, not by how
+	                       // loud they sound now
+	STEAL_LOWEST_PRIORITY, // the oldest held voice of the lowest-priority channel
+};
+
+// What a note-on does while as many voices sound as the load budget allows.
+enum overloadEnum {
+	OVERLOAD_STEAL,  // take a sounding voice, as by the steal policy
+	OVERLOAD_REFUSE, // play nothing
+};
+
+/**
+ * @brief Assigns MIDI notes to a set of voices in constant time.
+ *
+ * Every voice is on one of four intrusive lists, oldest first: free,
+ * releasing, held, or fading out after being shed for load. Held voices are also listed by channel and by
+ * velocity band, and a (channel, note) table finds the voice of a note, so
+ * a note-on or note-off costs a few list operations however many voices
+ * there are; nothing scans the voices or polls them. Each voice tells the
+ * manager when it goes idle (see AudioSynthWavetable::setIdleListener()),
+ * queuing its number from render(), and the next call into the manager
+ * moves the voices queued since onto the free list.
+ *
+ * Given a budget for the voices' render cost per block, it also keeps the
+ * number of sounding voices within what the budget pays for, see
+ * limitLoad().
+ *
+ * Call it from one context only (e.g. the MIDI callbacks in loop()); the
+ * voices themselves may be rendered from the audio interrupt meanwhile.
+ * The manager must outlive the voices' rendering, or be destroyed first.
+ *
+ * @tparam N the number of voices, e.g. the size of an AudioSynthWavetablePoly
+ */
+template <int N>
+class WavetableVoiceManager : public WavetableIdleListener
+{
+	typedef typename std::conditional<(N < 255), uint8_t, uint16_t>::type index_t;
+	static const index_t NONE = (index_t)-1;
+
+	static constexpr uint32_t power_of_two(uint32_t n, uint32_t p = 1) { return p >= n ? p : power_of_two(n, p * 2); }
+
+public:
+	/**
+	 * @brief Manage the voices voices[0] to voices[count-1].
+	 *
+	 * @param voices the voices, e.g. &pool[0] for an AudioSynthWavetablePoly
+	 * @param count a value between 1 and N
+	 */
+	WavetableVoiceManager(AudioSynthWavetable* voices, int count = N) : voices(voices), count(count), limit(count) {
+		for (int c = 0; c < VOICE_CHANNELS; ++c) {
+			instruments[c] = NULL;
+			priorities[c] = 0;
+			priority_order[c] = c;
+			for (int n = 0; n < 128; ++n) map[c][n] = NONE;
+		}
+		for (int i = 0; i < N; ++i) {
+			info[i].list = LIST_FREE;
+			info[i].channel = info[i].note = 0xFF;
+			info[i].instrument = NULL;
+			// voices past 'count' are never handed out
+			if (i < count) {
+				push(age, lists[LIST_FREE], i);
+				voices[i].setIdleListener(this, i);
+			}
+		}
+	}
+
+	~WavetableVoiceManager(void) {
+		for (int i = 0; i < count; ++i) voices[i].setIdleListener(NULL, 0);
+	}
+
+	/**
+	 * @brief Set the instrument a channel plays; notes on channels without
+	 * one are ignored by noteOn().
+	 *
+	 * @param channel 0 to 15
+	 * @param instrument the instrument, or NULL to mute the channel
+	 */
+	void setInstrument(uint8_t channel, const instrument_data* instrument) {
+		if (channel < VOICE_CHANNELS) instruments[channel] = instrument;
+	}
+
+	/**
+	 * @brief Choose which sounding voice a note takes when none is free.
+	 */
+	void setStealPolicy(voiceStealEnum policy) { this->policy = policy; }
+
+	/**
+	 * @brief Set how much a channel's notes are worth keeping under
+	 * STEAL_LOWEST_PRIORITY; channels of equal priority lose voices from
+	 * the lowest channel number up.
+	 *
+	 * @param channel 0 to 15
+	 * @param priority higher is kept longer, 0 by default
+	 */
+	void setChannelPriority(uint8_t channel, uint8_t priority) {
+		if (channel >= VOICE_CHANNELS) return;
+		priorities[channel] = priority;
+		// insertion sort of 16 channels, lowest priority first
+		for (int c = 0; c < VOICE_CHANNELS; ++c) priority_order[c] = c;
+		for (int i = 1; i < VOICE_CHANNELS; ++i) {
+			uint8_t c = priority_order[i];
+			int j = i;
+			for (; j > 0 && priorities[priority_order[j - 1]] > priorities[c]; --j) priority_order[j] = priority_order[j - 1];
+			priority_order[j] = c;
+		}
+	}
+
+	/**
+	 * @brief Choose whether a note played again while it sounds (held or
+	 * releasing) restarts on its own voice, the default, or takes another.
+	 */
+	void setRetrigger(bool on) { retrigger = on; }
+
+	/**
+	 * @brief Set the render cost per block the voices may take, in the units
+	 * passed to limitLoad(); 0, the default, turns load limiting off.
+	 */
+	void setLoadBudget(uint32_t budget) {
+		this->budget = budget;
+		limit = count;
+	}
+
+	/**
+	 * @brief Choose what a note-on does while as many voices sound as the
+	 * load budget allows.
+	 */
+	void setOverloadPolicy(overloadEnum policy) { overload = policy; }
+
+	/**
+	 * @brief Report what the last audio block cost to render, e.g. the
+	 * pool's cpu_cycles as AudioStream measured it (CPU cycles / 64 on the
+	 * Teensy, ns on a host), once per block. Over the budget, the voice
+	 * limit drops to the number of voices the budget pays for at the cost
+	 * measured, and the voices over it are faded out within 1.5 ms (see
+	 * AudioSynthWavetable::quickKill()): releasing voices first, then held
+	 * ones by the steal policy. Voices still fading out do not count against
+	 * the limit. Below 7/8 of the budget the limit grows back by one voice
+	 * per block. Call it from the context that plays the notes, not from an
+	 * interrupt.
+	 *
+	 * @param cost the render cost of the last block
+	 */
+	void limitLoad(uint32_t cost) {
+		reclaimFinished();
+		load = cost;
+		if (budget == 0) return;
+		// every voice but the free ones rendered the block measured
+		int rendered = count - lists[LIST_FREE].count;
+		if (cost > budget) {
+			++overloaded;
+			// voices cost about the same, so as many fit as the budget pays for
+			int fit = rendered ? (int)((uint64_t)budget * rendered / cost) : limit;
+			if (fit < limit) limit = fit > 1 ? fit : 1;
+			// voices shed earlier are still fading out and count against
+			// no limit, or each overloaded block would shed them again
+			for (int n = sounding() - limit; n > 0; --n) {
+				index_t v = lists[LIST_RELEASING].head != NONE ? lists[LIST_RELEASING].head
+					: lists[LIST_ACTIVE].head != NONE ? pickHeld() : NONE;
+				if (v == NONE) break;
+				voices[v].quickKill();
+				detach(v);
+				moveTo(v, LIST_FADING);
+				++shed;
+			}
+		} else if (cost < budget - budget / 8 && limit < count) {
+			++limit;
+		}
+	}
+
+	/**
+	 * @brief Play a note on a voice: a free one, the note's own voice if it
+	 * is retriggered, or one taken from another note. A note still sounding
+	 * on the voice fades out under the new one (see
+	 * AudioSynthWavetable::stealNote()) rather than being cut off.
+	 *
+	 * @param channel 0 to 15
+	 * @param note 0 to 127
+	 * @param velocity 1 to 127, other values clamped to that range
+	 * @param offset the sample of the next block to start on
+	 * @return the voice, or -1 if the channel has no instrument or the load
+	 * limit refuses the note
+	 */
+	int noteOn(uint8_t channel, uint8_t note, uint8_t velocity, int offset = 0) {
+		if (channel >= VOICE_CHANNELS || note > 127 || instruments[channel] == NULL) return -1;
+		velocity = clampVelocity(velocity);
+		int v = allocate(channel, note, velocity);
+		if (v < 0) return -1;
+		if (info[v].instrument != instruments[channel]) {
+			info[v].instrument = instruments[channel];
+			voices[v].setInstrument(*instruments[channel], false);
+		}
+		voices[v].stealNote(note, velocity, offset);
+		return v;
+	}
+
+	/**
+	 * @brief Release the voice holding a note.
+	 *
+	 * @param offset the sample of the next block to release on
+	 * @return the voice, or -1 if the note is not held
+	 */
+	int noteOff(uint8_t channel, uint8_t note, int offset = 0) {
+		reclaimFinished();
+		int v = findVoice(channel, note);
+		if (v < 0) return -1;
+		voices[v].stop(offset);
+		release(v);
+		return v;
+	}
+
+	/**
+	 * @brief The voice holding a note.
+	 *
+	 * @return the voice, or -1 if the note is not held
+	 */
+	int findVoice(uint8_t channel, uint8_t note) const {
+		if (channel >= VOICE_CHANNELS || note > 127) return -1;
+		index_t v = map[channel][note];
+		return v != NONE && info[v].list == LIST_ACTIVE ? v : -1;
+	}
+
+	/**
+	 * @brief Take a voice for a note and mark it held, without playing
+	 * anything on it; noteOn() does both.
+	 *
+	 * @return the voice, or -1 if the load limit refuses the note
+	 */
+	int allocate(uint8_t channel, uint8_t note, uint8_t velocity) {
+		reclaimFinished();
+		index_t v = retrigger ? map[channel][note] : NONE;
+		// at the load limit a new note takes a sounding voice, or none
+		bool limited = v == NONE && budget != 0 && sounding() >= limit;
+		if (limited && overload == OVERLOAD_REFUSE) {
+			++refused;
+			return -1;
+		}
+		if (v == NONE && !limited) v = lists[LIST_FREE].head;
+		if (v == NONE && lists[LIST_RELEASING].head == NONE && lists[LIST_ACTIVE].head == NONE) {
+			// every sounding voice is fading out already
+			v = lists[LIST_FREE].head != NONE ? lists[LIST_FREE].head : lists[LIST_FADING].head;
+		}
+		if (v == NONE) {
+			v = steal();
+			++stolen;
+		}
+		// a note played again without its voice retriggered is released
+		index_t previous = map[channel][note];
+		if (previous != NONE && previous != v && info[previous].list == LIST_ACTIVE) {
+			voices[previous].stop();
+			release(previous);
+		}
+
+		detach(v);
+		info[v].channel = channel;
+		info[v].note = note;
+		info[v].band = clampVelocity(velocity) * VOICE_BANDS / 128;
+		map[channel][note] = v;
+		moveTo(v, LIST_ACTIVE);
+		push(by_channel, channel_lists[channel], v);
+		push(by_band, band_lists[info[v].band], v);
+		channel_mask |= 1 << channel;
+		band_mask |= 1 << info[v].band;
+		return v;
+	}
+
+	/**
+	 * @brief Mark a held voice as releasing, without stopping it; noteOff()
+	 * does both.
+	 */
+	void release(int v) {
+		if (info[v].list != LIST_ACTIVE) return;
+		unlinkHeld(v);
+		moveTo(v, LIST_RELEASING);
+	}
+
+	/**
+	 * @brief Mark a voice as free, e.g. when its release has ended.
+	 */
+	void reclaim(int v) {
+		detach(v);
+		moveTo(v, LIST_FREE);
+	}
+
+	/**
+	 * @brief Free the voices that have gone idle since the last call; every
+	 * note-on and note-off starts with this.
+	 *
+	 * @return the number of voices freed
+	 */
+	int reclaimFinished(void) {
+		int freed = 0;
+		index_t v;
+		while (finished.pop(v)) {
+			// a voice given a new note since it was queued is not idle any more
+			if (info[v].list == LIST_FREE || voices[v].isPlaying()) continue;
+			reclaim(v);
+			++freed;
+		}
+		return freed;
+	}
+
+	/**
+	 * @brief Called from render() when a voice goes idle, see
+	 * WavetableIdleListener.
+	 */
+	virtual void voiceIdle(int id) { finished.push((index_t)id); }
+
+	/**
+	 * @brief Release every held voice.
+	 */
+	void allNotesOff(void) {
+		while (lists[LIST_ACTIVE].head != NONE) {
+			index_t v = lists[LIST_ACTIVE].head;
+			voices[v].stop();
+			release(v);
+		}
+	}
+
+	int heldVoices(void) const { return lists[LIST_ACTIVE].count; }
+	int releasingVoices(void) const { return lists[LIST_RELEASING].count; }
+	int freeVoices(void) const { return lists[LIST_FREE].count; }
+	int fadingVoices(void) const { return lists[LIST_FADING].count; }
+
+	/**
+	 * @brief The number of notes that took a sounding voice.
+	 */
+	uint32_t steals(void) const { return stolen; }
+
+	/**
+	 * @brief How many voices may sound at the load measured, see limitLoad().
+	 */
+	int voiceLimit(void) const { return limit; }
+
+	/**
+	 * @brief The cost last passed to limitLoad().
+	 */
+	uint32_t lastLoad(void) const { return load; }
+
+	/**
+	 * @brief The number of blocks over the load budget.
+	 */
+	uint32_t overloads(void) const { return overloaded; }
+
+	/**
+	 * @brief The number of voices faded out to get back within the budget.
+	 */
+	uint32_t shedVoices(void) const { return shed; }
+
+	/**
+	 * @brief The number of notes refused under OVERLOAD_REFUSE.
+	 */
+	uint32_t refusedNotes(void) const { return refused; }
+
+private:
+	// fading: shed by limitLoad(), on no note and not to be stolen
+	enum { LIST_FREE, LIST_RELEASING, LIST_FADING, LIST_ACTIVE, LIST_COUNT };
+
+	struct links { index_t prev, next; };
+	struct list { index_t head = NONE, tail = NONE; int count = 0; };
+	struct voice_info {
+		uint8_t list, channel, note, band;
+		const instrument_data* instrument;
+	};
+
+	// MIDI data bytes are 7-bit, but a malformed file can deliver any byte
+	static uint8_t clampVelocity(uint8_t velocity) {
+		return velocity < 1 ? 1 : velocity > 127 ? 127 : velocity;
+	}
+
+	// the voices on a note or releasing one, which the load limit counts
+	int sounding(void) const { return lists[LIST_RELEASING].count + lists[LIST_ACTIVE].count; }
+
+	static void push(links* l, list& to, index_t v) {
+		l[v].prev = to.tail;
+		l[v].next = NONE;
+		if (to.tail != NONE) l[to.tail].next = v;
+		else to.head = v;
+		to.tail = v;
+		++to.count;
+	}
+
+	static void unlink(links* l, list& from, index_t v) {
+		if (l[v].prev != NONE) l[l[v].prev].next = l[v].next;
+		else from.head = l[v].next;
+		if (l[v].next != NONE) l[l[v].next].prev = l[v].prev;
+		else from.tail = l[v].prev;
+		--from.count;
+	}
+
+	void moveTo(index_t v, int to) {
+		unlink(age, lists[info[v].list], v);
+		info[v].list = to;
+		push(age, lists[to], v);
+	}
+
+	// take a held voice off its channel and band lists
+	void unlinkHeld(index_t v) {
+		uint8_t channel = info[v].channel, band = info[v].band;
+		unlink(by_channel, channel_lists[channel], v);
+		unlink(by_band, band_lists[band], v);
+		if (channel_lists[channel].head == NONE) channel_mask &= ~(1 << channel);
+		if (band_lists[band].head == NONE) band_mask &= ~(1 << band);
+	}
+
+	// forget the note a voice was playing, before it takes another
+	void detach(index_t v) {
+		if (info[v].list == LIST_ACTIVE) unlinkHeld(v);
+		if (info[v].channel < VOICE_CHANNELS && map[info[v].channel][info[v].note] == v)
+			map[info[v].channel][info[v].note] = NONE;
+	}
+
+	index_t steal(void) {
+		if (lists[LIST_RELEASING].head != NONE) return lists[LIST_RELEASING].head;
+		return pickHeld();
+	}
+
+	// the held voice the steal policy gives up first
+	index_t pickHeld(void) {
+		if (policy == STEAL_SOFTEST) return band_lists[__builtin_ctz(band_mask)].head;
+		if (policy == STEAL_LOWEST_PRIORITY) {
+			for (int i = 0; i < VOICE_CHANNELS; ++i)
+				if (channel_mask & (1 << priority_order[i])) return channel_lists[priority_order[i]].head;
+		}
+		return lists[LIST_ACTIVE].head;
+	}
+
+	AudioSynthWavetable* voices;
+	int count;
+	// a voice queues itself once per note, and may be given a new note
+	// once between being queued and taken off again, so 2N always fit
+	WavetableQueue<index_t, power_of_two(2 * N)> finished;
+	const instrument_data* instruments[VOICE_CHANNELS];
+	voiceStealEnum policy = STEAL_OLDEST;
+	bool retrigger = true;
+	uint8_t priorities[VOICE_CHANNELS];
+	uint8_t priority_order[VOICE_CHANNELS];
+	uint32_t stolen = 0;
+	overloadEnum overload = OVERLOAD_STEAL;
+	int limit;
+	uint32_t budget = 0, load = 0, overloaded = 0, shed = 0, refused = 0;
+
+	index_t map[VOICE_CHANNELS][128];
+	voice_info info[N];
+	links age[N], by_channel[N], by_band[N];
+	list lists[LIST_COUNT], channel_lists[VOICE_CHANNELS], band_lists[VOICE_BANDS];
+	uint16_t channel_mask = 0;
+	uint8_t band_mask = 0;
+};
@@ -32,8 +32,19 @@ import getopt
 import inspect
 import re
 import math
+import struct
 
 DEBUG_FLAG = False
+# Number of octave-decimated copies exported per sample (-m); 0 exports none
+MIP_LEVELS = 0
+# Half-length of the decimation filter, in taps per octave of decimation
+MIP_FILTER_HALF_TAPS = 8
+MIP_FILTER_KAISER_BETA = 8.0
+# Padding before and after every exported sample array; must be at least
+# WAVETABLE_GUARD_SAMPLES in wavetable_kernels.h
+GUARD_SAMPLES = 4
+# Entries in each instrument's note-to-sample table; NOTE_COUNT in sample_data.h
+NOTE_COUNT = 128
 logging.disable(logging.WARNING)
 
 def print_debug(flag, message, function=None):
@@ -97,12 +108,13 @@ def menu(choices):
 
 def main(argv):
     global DEBUG_FLAG
+    global MIP_LEVELS
     # Disable warning logging to prevent sf2utils from logging any un-needed messages
     logging.disable(logging.WARNING)
 
     path = None
     try:
-        opts, args = getopt.getopt(argv, 'di:o:', ['ifile=', 'ofile='])
+        opts, args = getopt.getopt(argv, 'di:o:m:', ['ifile=', 'ofile=', 'mip-levels='])
     except getopt.GetoptError:
         print('INVALID ARGUMENTS')
         sys.exit(2)
@@ -113,6 +125,8 @@ def main(argv):
             path = arg
         elif opt in ('-o', '--ofile'):
             outFile = arg
+        elif opt in ('-m', '--mip-levels'):
+            MIP_LEVELS = int(arg)
 
     print(150*'\n')
     print('       WELCOME  ')
@@ -176,7 +190,7 @@ def main(argv):
         else:   # shouldn't be reached
             input("Wrong option selection. Enter any key to try again..")
 
-def decode_selected(path, inst_index, selected_bags, global_bag_index, user_title=None, user_dir=None):
+def decode_selected(path, inst_index, selected_bags, global_bag_index, user_title=None, user_dir=None, mip_levels=None):
     with open(path, 'rb') as file:
         sf2 = Sf2File(file)
 
@@ -198,10 +212,11 @@ def decode_selected(path, inst_index, selected_bags, global_bag_index, user_titl
         file_title = user_title if user_title else sf2.instruments[inst_index].name
 
         file_title = re.sub(r'[\W]+', '', file_title)
+        mip_levels = MIP_LEVELS if mip_levels is None else mip_levels
         if user_dir is not None:
-            export_samples(bags_to_decode, global_bag, len(bags_to_decode), file_title=file_title, file_dir=user_dir)
+            export_samples(bags_to_decode, global_bag, len(bags_to_decode), file_title=file_title, file_dir=user_dir, mip_levels=mip_levels)
         else:
-            export_samples(bags_to_decode, global_bag, len(bags_to_decode), file_title=file_title)
+            export_samples(bags_to_decode, global_bag, len(bags_to_decode), file_title=file_title, mip_levels=mip_levels)
         return True
 
 
@@ -210,7 +225,9 @@ def decode_all(path, inst_index, global_bag_index):
 
 
 # Write a sample out to C++ style data files.
-def export_samples(bags, global_bag, num_samples, file_title="samples", file_dir="."):
+# With mip_levels > 0 every sample is followed by that many band-limited
+# copies, each decimated by a further octave (see decimate_sample).
+def export_samples(bags, global_bag, num_samples, file_title="samples", file_dir=".", mip_levels=0):
     instrument_name = file_title
     h_file_name = "{}_samples.h".format(instrument_name)
     cpp_file_name = "{}_samples.cpp".format(instrument_name)
@@ -227,63 +244,155 @@ def export_samples(bags, global_bag, num_samples, file_title="samples", file_dir
         for keyRange in keyRanges:
             h_file.write("{0}, ".format(keyRange[1]))
         h_file.write("};\n\n")
-        h_file.write("const instrument_data {0} = {{{1}, {0}_ranges, {0}_samples }};\n\n".format(instrument_name, num_samples))
+        band_starts, velocity_bands = get_velocity_bands(bags)
+        zone_map = get_zone_map(bags, band_starts)
+        if len(band_starts) > 1:
+            h_file.write("const uint8_t {0}_velocity_bands[128] = {{\n".format(instrument_name))
+            for row in range(0, 128, 32):
+                h_file.write("".join("{0},".format(b) for b in velocity_bands[row:row + 32]) + "\n")
+            h_file.write("};\n\n")
+        h_file.write("const uint8_t {0}_notes[NOTE_COUNT * {1}] = {{\n".format(instrument_name, len(band_starts)))
+        for row in range(0, len(zone_map), 32):
+            h_file.write("".join("{0},".format(i) for i in zone_map[row:row + 32]) + "\n")
+        h_file.write("};\n\n")
+        h_file.write("constexpr instrument_data {0} = {{{1}, {0}_ranges, {0}_samples, {0}_notes, {2}, {3} }};\n\n".format(
+            instrument_name, num_samples, len(band_starts), instrument_name + "_velocity_bands" if len(band_starts) > 1 else "NULL"))
+
+        levels = [sample_mip_levels(bags[i], mip_levels) for i in range(len(bags))]
 
         cpp_file.write("#include \"{}\"\n".format(h_file_name))
-        cpp_file.write("const sample_data {0}_samples[{1}] = {{\n".format(instrument_name, num_samples))
+        # constexpr, so the compiler rejects anything that would need startup code
+        cpp_file.write("constexpr sample_data {0}_samples[{1}] = {{\n".format(instrument_name, num_samples))
         for i in range(len(bags)):
-            out_str = gen_sample_meta_data_string(bags[i], global_bag if global_bag else bags[i], i, instrument_name, keyRanges[i])
+            out_str = gen_sample_meta_data_string(bags[i], global_bag if global_bag else bags[i], i, instrument_name, keyRanges[i], levels[i])
             cpp_file.write(out_str)
         cpp_file.write("};\n")
+        for i in range(len(bags)):
+            cpp_file.write("static_assert(sample_data_valid({0}_samples[{1}]), \"sample {1} of {0}\");\n".format(instrument_name, i))
 
         for i in range(len(bags)):
-            raw_wav_data = bags[i].sample.raw_sample_data
-            length_16 = bags[i].sample.duration
-            length_8 = length_16 * 2
-            length_32 = math.ceil(length_16 / 2)
-            pad_length = 0 if length_32 % 128 == 0 else 128 - length_32 % 128
-
-            ary_length = int(length_32 + pad_length)
-
-            smpl_identifier = "sample_{0}_{1}_{2}[{3}]"\
-                .format(i, instrument_name, re.sub(r'[\W]+', '', bags[i].sample.name), ary_length)
-
-            # Write array init to header file.
-            h_file.write("\nextern const uint32_t {0};\n".format(smpl_identifier))
-
-            # Write array contents to .cpp
-            cpp_file.write("\nconst uint32_t {0} = {{\n".format(smpl_identifier))
-
-            # Output 32-bit hex literals
-            line_width = 0
-            for j in range(0, length_8, 4):
-                out_bytes = raw_wav_data[j:j+4]
-                if len(out_bytes) != 4:
-                    out_bytes += bytes(4 - len(out_bytes))
-                hex_str = ''.join(['{:02x}'.format(out_bytes[k]) for k in range(3, -1, -1)])
-                cpp_file.write('0x{},'.format(hex_str))
-                line_width += 1
-                if line_width == 8:
-                    line_width = 0
-                    cpp_file.write('\n')
-            while pad_length > 0:
-                cpp_file.write('0x00000000,')
-                line_width += 1
-                if line_width == 8:
-                    line_width = 0
-                    cpp_file.write('\n')
-                pad_length -= 4
-            cpp_file.write("};\n" if line_width == 8 else "\n};\n")
+            sample_name = "sample_{0}_{1}_{2}".format(i, instrument_name, re.sub(r'[\W]+', '', bags[i].sample.name))
+            g_bag = global_bag if global_bag else bags[i]
+            looped = bags[i].sample_loop == 1 or g_bag.sample_loop == 1
+            loop_start = bags[i].cooked_loop_start if looped else None
+            loop_end = bags[i].cooked_loop_end if looped else None
+            data = struct.unpack("<{}h".format(bags[i].sample.duration), bags[i].sample.raw_sample_data[:bags[i].sample.duration * 2])
+
+            padded = guard_sample(data, loop_start, loop_end)
+            write_sample_array(cpp_file, h_file, sample_name, struct.pack("<{}h".format(len(padded)), *padded), len(padded))
+            if levels[i] == 0:
+                continue
+
+            for level in range(1, levels[i] + 1):
+                mip = decimate_sample(data, level, loop_start, loop_end)
+                write_sample_array(cpp_file, h_file, "{}_mip{}".format(sample_name, level), struct.pack("<{}h".format(len(mip)), *mip), len(mip))
+
+            mips = "{}_mips[{}]".format(sample_name, levels[i])
+            h_file.write("\nextern const int16_t* const {0};\n".format(mips))
+            cpp_file.write("\nconstexpr const int16_t* {0} = {{{1}}};\n".format(mips,
+                ", ".join("{}_mip{} + {}".format(sample_name, level, GUARD_SAMPLES) for level in range(1, levels[i] + 1))))
+
+
+# Pads a sample with GUARD_SAMPLES samples on either side, so the player can
+# read every interpolation tap without bounds checks: silence before the start,
+# and after the loop end a copy of the loop start (the player wraps from
+# phase (loop_end-1) back to (loop_start-1)), or silence after a one-shot.
+def guard_sample(data, loop_start=None, loop_end=None):
+    padded = [0] * GUARD_SAMPLES + list(data) + [0] * GUARD_SAMPLES
+    if loop_start is not None and loop_end is not None and loop_end > loop_start:
+        for j in range(GUARD_SAMPLES):
+            padded[GUARD_SAMPLES + loop_end - 1 + j] = data[loop_start - 1 + j]
+    return padded
+
+
+# Write 16-bit PCM data as an array of int16_t literals, zero-padded to a
+# multiple of 256 samples. Earlier output packed pairs of samples into 32-bit
+# hex words, but reading those as int16_t takes a cast that keeps the
+# sample_data pointing at them from being a constant expression.
+def write_sample_array(cpp_file, h_file, name, raw_wav_data, length_16):
+    data = struct.unpack("<{}h".format(length_16), raw_wav_data[:length_16 * 2])
+    pad_length = 0 if length_16 % 256 == 0 else 256 - length_16 % 256
+    data = list(data) + [0] * pad_length
+
+    smpl_identifier = "{0}[{1}]".format(name, len(data))
+
+    # Write array init to header file.
+    h_file.write("\nextern const int16_t {0};\n".format(smpl_identifier))
+
+    # Write array contents to .cpp, 16 samples per line
+    cpp_file.write("\nconstexpr int16_t {0} __attribute__((aligned(16))) = {{\n".format(smpl_identifier))
+    for j in range(0, len(data), 16):
+        cpp_file.write("".join("{0},".format(v) for v in data[j:j + 16]) + "\n")
+    cpp_file.write("};\n")
+
+
+# Number of mip levels to export for a sample: the requested number, but never
+# so many that the smallest copy is shorter than 16 samples.
+def sample_mip_levels(bag, mip_levels):
+    length_bits = bag.sample.duration.bit_length()
+    return max(0, min(mip_levels, length_bits - 5))
+
+
+def bessel_i0(x):
+    total, term, k = 1.0, 1.0, 1
+    while term > 1e-12 * total:
+        term *= (x / (2 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+# Band-limits 'data' to 0.45/2**level of its sample rate with a Kaiser-windowed
+# sinc and keeps every 2**level-th sample, so that copy k played with a phase
+# increment of up to one of its samples per output sample does not alias.
+# The copy holds ((len(data)-1) >> level) + 2 samples, one more than the player
+# can index, plus GUARD_SAMPLES on either side. For looped samples the data past
+# the loop end is taken to repeat the loop, keeping every level seamless and
+# making its guard samples a copy of the loop start.
+def decimate_sample(data, level, loop_start=None, loop_end=None):
+    factor = 1 << level
+    half = MIP_FILTER_HALF_TAPS * factor
+    cutoff = 0.45 / factor
+    kernel = []
+    for j in range(-half, half + 1):
+        x = 2 * cutoff * j
+        sinc = 1.0 if j == 0 else math.sin(math.pi * x) / (math.pi * x)
+        r = j / float(half + 1)
+        kernel.append(sinc * bessel_i0(MIP_FILTER_KAISER_BETA * math.sqrt(1 - r * r)))
+    total = sum(kernel)
+    kernel = [k / total for k in kernel]
+
+    # the player wraps from phase (loop_end-1) back to (loop_start-1)
+    looped = loop_start is not None and loop_end is not None and loop_end > loop_start
+    if looped:
+        loop_first = loop_start - 1
+        loop_length = loop_end - loop_start
+
+    def at(i):
+        if i < 0:
+            return 0
+        if looped and i >= loop_first + loop_length:
+            i = loop_first + (i - loop_first) % loop_length
+        return data[i] if i < len(data) else 0
+
+    out = []
+    for m in range(-GUARD_SAMPLES, ((len(data) - 1) >> level) + 2 + GUARD_SAMPLES):
+        centre = m * factor
+        acc = 0.0
+        for j in range(-half, half + 1):
+            acc += kernel[j + half] * at(centre + j)
+        out.append(max(-32768, min(32767, int(round(acc)))))
+    return out
 
 
 # prints out the sample metadata into the first portion of the sample array
-def gen_sample_meta_data_string(bag, global_bag, sample_num, instrument_name, keyRange):
+def gen_sample_meta_data_string(bag, global_bag, sample_num, instrument_name, keyRange, mip_levels=0):
     out_fmt_str = \
         "\t{{\n" \
-        "\t\t(int16_t*){SAMPLE_ARRAY_NAME},\t//16-bit PCM encoded audio sample\n" \
+        "\t\t{SAMPLE_ARRAY_NAME} + {GUARD_SAMPLES},\t//16-bit PCM encoded audio sample, after the guard samples\n" \
         "\t\t{LOOP},\t//Whether or not to loop this sample\n" \
         "\t\t{LENGTH_BITS},\t//Number of bits needed to hold length\n" \
-        "\t\t({PHASE_MULT}*{CENTS_OFFSET}*({SAMPLE_RATE} / AUDIO_SAMPLE_RATE_EXACT)) / {SAMPLE_FREQ} + 0.5,\t//((0x80000000 >> (index_bits - 1)) * cents_offset * sampling_rate / AUDIO_SAME_RATE_EXACT) / sample_freq + 0.5\n" \
+        "\t\t({PHASE_MULT}*{CENTS_OFFSET}*({SAMPLE_RATE} / AUDIO_SAMPLE_RATE_EXACT)) / {SAMPLE_FREQ},\t//((0x80000000 >> (index_bits - 1)) * cents_offset * sampling_rate / AUDIO_SAME_RATE_EXACT) / sample_freq\n" \
         "\t\t((uint32_t){LENGTH}-1) << (32 - {LENGTH_BITS}),\t//(sample_length-1) << (32 - sample_length_bits)\n" \
         "\t\t((uint32_t){LOOP_END}-1) << (32 - {LENGTH_BITS}),\t//(loop_end-1) << (32 - sample_length_bits) == LOOP_PHASE_END\n" \
         "\t\t(((uint32_t){LOOP_END}-1) << (32 - {LENGTH_BITS})) - (((uint32_t){LOOP_START}-1) << (32 - {LENGTH_BITS})),\t//LOOP_PHASE_END - (loop_start-1) << (32 - sample_length_bits) == LOOP_PHASE_END - LOOP_PHASE_START == LOOP_PHASE_LENGTH\n" \
@@ -304,6 +413,9 @@ def gen_sample_meta_data_string(bag, global_bag, sample_num, instrument_name, ke
         "\t\t(1.0 - CENTS_SHIFT({MOD_PITCH}/1000.0))*4, // MODULATION_PITCH_COEFFICIENT_SECOND\n" \
         "\t\tint32_t(UINT16_MAX * (DECIBEL_SHIFT(-0.1) - 1.0)) *4, // MODULATION_AMPLITUDE_INITIAL_GAIN\n" \
         "\t\tint32_t(UINT16_MAX * (1.0 - DECIBEL_SHIFT(0.1))) *4, // MODULATION_AMPLITUDE_FINAL_GAIN\n" \
+        "\t\t{MIP_LEVELS},\t//Number of band-limited copies, each decimated by a further octave\n" \
+        "\t\t{MIP_ARRAY_NAME},\t//Band-limited copies\n" \
+        "\t\t{GUARD_SAMPLES},\t//Guard samples before the start and after the loop end or end\n" \
         "\t}},\n"
 
     base_note = bag.base_note if bag.base_note else bag.sample.original_pitch
@@ -333,6 +445,9 @@ def gen_sample_meta_data_string(bag, global_bag, sample_num, instrument_name, ke
         "VELOCITY_RANGE_LOWER": bag.velocity_range[0] if bag.velocity_range else 0,
         "VELOCITY_RANGE_UPPER": bag.velocity_range[1] if bag.velocity_range else 0,
         "SAMPLE_ARRAY_NAME": "sample_{0}_{1}_{2}".format(sample_num, instrument_name, re.sub(r'[\W]+', '', bag.sample.name)),
+        "MIP_LEVELS": mip_levels,
+        "GUARD_SAMPLES": GUARD_SAMPLES,
+        "MIP_ARRAY_NAME": "sample_{0}_{1}_{2}_mips".format(sample_num, instrument_name, re.sub(r'[\W]+', '', bag.sample.name)) if mip_levels else "NULL",
     }
 
     sustain_env = bag.volume_envelope_sustain if bag.volume_envelope_sustain else global_bag.volume_envelope_sustain
@@ -360,7 +475,8 @@ def gen_sample_meta_data_string(bag, global_bag, sample_num, instrument_name, ke
         "MOD_PITCH": bag.gens[5].absolute_cents if 5 in bag.gens else global_bag.gens[5].absolute_cents if 5 in global_bag.gens else None,
         "INIT_ATTENUATION": bag.gens[48].attenuation if 48 in bag.gens else global_bag.gens[48].attenuation if 48 in global_bag.gens else None,
     }
-    env_vals = {k: int(env_vals[k] * 1000) if env_vals[k] else 0 for k in env_vals}
+    # times in seconds become milliseconds; the sustain level is already a fraction
+    env_vals = {k: env_vals[k] if k == "SUSTAIN_FRAC" else int(env_vals[k] * 1000) if env_vals[k] else 0 for k in env_vals}
 
     return out_fmt_str.format(**out_vals, **env_vals)
 
@@ -377,6 +493,36 @@ def note_to_freq(note):
     freq = float(pow(2, exp)) * 440.0
     return freq
 
+# Splits the velocities 0-127 into bands at every velocity range boundary.
+# Returns the lowest velocity of each band and the band of every velocity.
+def get_velocity_bands(bags):
+    starts = {0}
+    for bag in bags:
+        if bag.velocity_range:
+            starts.add(bag.velocity_range[0])
+            if bag.velocity_range[1] < 127:
+                starts.add(bag.velocity_range[1] + 1)
+    starts = sorted(s for s in starts if 0 <= s <= 127)
+    bands = [max(b for b in range(len(starts)) if starts[b] <= v) for v in range(128)]
+    return starts, bands
+
+
+# Maps every (MIDI note, velocity band) to the index of the sample (in bag
+# order) that plays it, flattened as map[note * len(band_starts) + band]. The
+# zone whose key and velocity ranges hold the note and the band is picked;
+# notes or velocities no zone covers go to the nearest zone, the lower one
+# on a tie.
+def get_zone_map(bags, band_starts):
+    def distance(r, x):
+        return 0 if r is None else max(r[0] - x, x - r[1], 0)
+
+    def zone(note, velocity):
+        return min(range(len(bags)), key=lambda i: (distance(bags[i].key_range, note),
+            distance(bags[i].velocity_range, velocity), bags[i].key_range[0] if bags[i].key_range else 0, i))
+
+    return [zone(note, velocity) for note in range(NOTE_COUNT) for velocity in band_starts]
+
+
 # Retrieves all key ranges for the samples and expands them to fill empty
 # space in the 0-127 range if needed.
 def getKeyRanges(bags, keyRanges):
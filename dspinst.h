@@ -37,7 +37,7 @@ static inline int32_t signed_saturate_rshift(int32_t val, int bits, int rshift)
 	int32_t out;
 	asm volatile("ssat %0, %1, %2, asr %3" : "=r" (out) : "I" (bits), "r" (val), "I" (rshift));
 	return out;
-#elif defined(KINETISL)
+#else
 	int32_t out, max;
 	out = val >> rshift;
 	max = 1 << (bits - 1);
@@ -60,8 +60,8 @@ static inline int16_t saturate16(int32_t val)
 	asm volatile("ssat %0, %1, %2" : "=r" (tmp) : "I" (16), "r" (val) );
 	out = (int16_t) (tmp & 0xffff); // not sure if the & 0xffff is necessary. test.
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else
+	return val > 32767 ? 32767 : val < -32768 ? -32768 : val;
 #endif
 }
 
@@ -73,7 +73,7 @@ static inline int32_t signed_multiply_32x16b(int32_t a, uint32_t b)
 	int32_t out;
 	asm volatile("smulwb %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else
 	return ((int64_t)a * (int16_t)(b & 0xFFFF)) >> 16;
 #endif
 }
@@ -86,7 +86,7 @@ static inline int32_t signed_multiply_32x16t(int32_t a, uint32_t b)
 	int32_t out;
 	asm volatile("smulwt %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else
 	return ((int64_t)a * (int16_t)(b >> 16)) >> 16;
 #endif
 }
@@ -99,8 +99,8 @@ static inline int32_t multiply_32x32_rshift32(int32_t a, int32_t b)
 	int32_t out;
 	asm volatile("smmul %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else
+	return ((int64_t)a * b) >> 32;
 #endif
 }
 
@@ -112,8 +112,8 @@ static inline int32_t multiply_32x32_rshift32_rounded(int32_t a, int32_t b)
 	int32_t out;
 	asm volatile("smmulr %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else
+	return ((int64_t)a * b + 0x80000000) >> 32;
 #endif
 }
 
@@ -125,8 +125,8 @@ static inline int32_t multiply_accumulate_32x32_rshift32_rounded(int32_t sum, in
 	int32_t out;
 	asm volatile("smmlar %0, %2, %3, %1" : "=r" (out) : "r" (sum), "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else
+	return (((int64_t)sum << 32) + (int64_t)a * b + 0x80000000) >> 32;
 #endif
 }
 
@@ -138,8 +138,8 @@ static inline int32_t multiply_subtract_32x32_rshift32_rounded(int32_t sum, int3
 	int32_t out;
 	asm volatile("smmlsr %0, %2, %3, %1" : "=r" (out) : "r" (sum), "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
-	return 0; // TODO....
+#else
+	return (((int64_t)sum << 32) - (int64_t)a * b + 0x80000000) >> 32;
 #endif
 }
 
@@ -152,7 +152,7 @@ static inline uint32_t pack_16t_16t(int32_t a, int32_t b)
 	int32_t out;
 	asm volatile("pkhtb %0, %1, %2, asr #16" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else
 	return (a & 0xFFFF0000) | ((uint32_t)b >> 16);
 #endif
 }
@@ -165,7 +165,7 @@ static inline uint32_t pack_16t_16b(int32_t a, int32_t b)
 	int32_t out;
 	asm volatile("pkhtb %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
-#elif defined(KINETISL)
+#else
 	return (a & 0xFFFF0000) | (b & 0x0000FFFF);
 #endif
 }
@@ -178,8 +178,8 @@ static inline uint32_t pack_16b_16b(int32_t a, int32_t b)
 	int32_t out;
 	asm volatile("pkhbt %0, %1, %2, lsl #16" : "=r" (out) : "r" (b), "r" (a));
 	return out;
-#elif defined(KINETISL)
-	return (a << 16) | (b & 0x0000FFFF);
+#else
+	return ((uint32_t)a << 16) | (b & 0x0000FFFF);
 #endif
 }
 
@@ -198,157 +198,240 @@ static inline uint32_t pack_16x16(int32_t a, int32_t b)
 static inline uint32_t signed_add_16_and_16(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline uint32_t signed_add_16_and_16(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("qadd16 %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	int32_t lo = (int16_t)a + (int16_t)b;
+	int32_t hi = (int16_t)(a >> 16) + (int16_t)(b >> 16);
+	lo = lo > 32767 ? 32767 : lo < -32768 ? -32768 : lo;
+	hi = hi > 32767 ? 32767 : hi < -32768 ? -32768 : hi;
+	return ((uint32_t)hi << 16) | (lo & 0xFFFF);
+#endif
 }
 
 // computes (((a[31:16] - b[31:16]) << 16) | (a[15:0 - b[15:0]))  (saturates)
 static inline int32_t signed_subtract_16_and_16(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline int32_t signed_subtract_16_and_16(int32_t a, int32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("qsub16 %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	int32_t lo = (int16_t)a - (int16_t)b;
+	int32_t hi = (int16_t)(a >> 16) - (int16_t)(b >> 16);
+	lo = lo > 32767 ? 32767 : lo < -32768 ? -32768 : lo;
+	hi = hi > 32767 ? 32767 : hi < -32768 ? -32768 : hi;
+	return ((uint32_t)hi << 16) | (lo & 0xFFFF);
+#endif
 }
 
 // computes out = (((a[31:16]+b[31:16])/2) <<16) | ((a[15:0]+b[15:0])/2)
 static inline int32_t signed_halving_add_16_and_16(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline int32_t signed_halving_add_16_and_16(int32_t a, int32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("shadd16 %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	int32_t lo = ((int16_t)a + (int16_t)b) >> 1;
+	int32_t hi = ((int16_t)(a >> 16) + (int16_t)(b >> 16)) >> 1;
+	return ((uint32_t)hi << 16) | (lo & 0xFFFF);
+#endif
 }
 
 // computes out = (((a[31:16]-b[31:16])/2) <<16) | ((a[15:0]-b[15:0])/2)
 static inline int32_t signed_halving_subtract_16_and_16(int32_t a, int32_t b) __attribute__((always_inline, unused));
 static inline int32_t signed_halving_subtract_16_and_16(int32_t a, int32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("shsub16 %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	int32_t lo = ((int16_t)a - (int16_t)b) >> 1;
+	int32_t hi = ((int16_t)(a >> 16) - (int16_t)(b >> 16)) >> 1;
+	return ((uint32_t)hi << 16) | (lo & 0xFFFF);
+#endif
 }
 
 // computes (sum + ((a[31:0] * b[15:0]) >> 16))
 static inline int32_t signed_multiply_accumulate_32x16b(int32_t sum, int32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t signed_multiply_accumulate_32x16b(int32_t sum, int32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smlawb %0, %2, %3, %1" : "=r" (out) : "r" (sum), "r" (a), "r" (b));
 	return out;
+#else
+	return (uint32_t)sum + (uint32_t)(((int64_t)a * (int16_t)(b & 0xFFFF)) >> 16);
+#endif
 }
 
 // computes (sum + ((a[31:0] * b[31:16]) >> 16))
 static inline int32_t signed_multiply_accumulate_32x16t(int32_t sum, int32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t signed_multiply_accumulate_32x16t(int32_t sum, int32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smlawt %0, %2, %3, %1" : "=r" (out) : "r" (sum), "r" (a), "r" (b));
 	return out;
+#else
+	return (uint32_t)sum + (uint32_t)(((int64_t)a * (int16_t)(b >> 16)) >> 16);
+#endif
 }
 
 // computes logical and, forces compiler to allocate register and use single cycle instruction
 static inline uint32_t logical_and(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline uint32_t logical_and(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	asm volatile("and %0, %1" : "+r" (a) : "r" (b));
 	return a;
+#else
+	return a & b;
+#endif
 }
 
 // computes ((a[15:0] * b[15:0]) + (a[31:16] * b[31:16]))
 static inline int32_t multiply_16tx16t_add_16bx16b(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_16tx16t_add_16bx16b(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smuad %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	return (uint32_t)((int16_t)a * (int16_t)b) + (uint32_t)((int16_t)(a >> 16) * (int16_t)(b >> 16));
+#endif
 }
 
 // computes ((a[15:0] * b[31:16]) + (a[31:16] * b[15:0]))
 static inline int32_t multiply_16tx16b_add_16bx16t(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_16tx16b_add_16bx16t(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smuadx %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	return (uint32_t)((int16_t)a * (int16_t)(b >> 16)) + (uint32_t)((int16_t)(a >> 16) * (int16_t)b);
+#endif
 }
 
 // // computes sum += ((a[15:0] * b[15:0]) + (a[31:16] * b[31:16]))
 static inline int64_t multiply_accumulate_16tx16t_add_16bx16b(int64_t sum, uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	asm volatile("smlald %Q0, %R0, %1, %2" : "+r" (sum) : "r" (a), "r" (b));
 	return sum;
+#else
+	return sum + (int16_t)a * (int16_t)b + (int64_t)((int16_t)(a >> 16) * (int16_t)(b >> 16));
+#endif
 }
 
 // // computes sum += ((a[15:0] * b[31:16]) + (a[31:16] * b[15:0]))
 static inline int64_t multiply_accumulate_16tx16b_add_16bx16t(int64_t sum, uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	asm volatile("smlaldx %Q0, %R0, %1, %2" : "+r" (sum) : "r" (a), "r" (b));
 	return sum;
+#else
+	return sum + (int16_t)a * (int16_t)(b >> 16) + (int64_t)((int16_t)(a >> 16) * (int16_t)b);
+#endif
 }
 
 // computes ((a[15:0] * b[15:0])
 static inline int32_t multiply_16bx16b(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_16bx16b(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smulbb %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	return (int16_t)a * (int16_t)b;
+#endif
 }
 
 // computes ((a[15:0] * b[31:16])
 static inline int32_t multiply_16bx16t(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_16bx16t(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smulbt %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	return (int16_t)a * (int16_t)(b >> 16);
+#endif
 }
 
 // computes ((a[31:16] * b[15:0])
 static inline int32_t multiply_16tx16b(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_16tx16b(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smultb %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	return (int16_t)(a >> 16) * (int16_t)b;
+#endif
 }
 
 // computes ((a[31:16] * b[31:16])
 static inline int32_t multiply_16tx16t(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t multiply_16tx16t(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("smultt %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	return (int16_t)(a >> 16) * (int16_t)(b >> 16);
+#endif
 }
 
 // computes (a - b), result saturated to 32 bit integer range
 static inline int32_t substract_32_saturate(uint32_t a, uint32_t b) __attribute__((always_inline, unused));
 static inline int32_t substract_32_saturate(uint32_t a, uint32_t b)
 {
+#if defined(KINETISK)
 	int32_t out;
 	asm volatile("qsub %0, %1, %2" : "=r" (out) : "r" (a), "r" (b));
 	return out;
+#else
+	int64_t out = (int64_t)(int32_t)a - (int32_t)b;
+	return out > INT32_MAX ? INT32_MAX : out < INT32_MIN ? INT32_MIN : out;
+#endif
 }
 
 //get Q from PSR
 static inline uint32_t get_q_psr(void) __attribute__((always_inline, unused));
 static inline uint32_t get_q_psr(void)
 {
+#if defined(KINETISK)
   uint32_t out;
   asm ("mrs %0, APSR" : "=r" (out));
   return (out & 0x8000000)>>27;
+#else
+	return 0;
+#endif
 }
 
 //clear Q BIT in PSR
 static inline void clr_q_psr(void) __attribute__((always_inline, unused));
 static inline void clr_q_psr(void)
 {
+#if defined(KINETISK)
   uint32_t t;
   asm ("mov %[t],#0\n"
        "msr APSR_nzcvq,%0\n" : [t] "=&r" (t)::"cc"); 
+#endif
 }
 
 #endif
@@ -0,0 +1,75 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Minimal stand-in for the Teensyduino core so the library can be built and
+// profiled on a desktop host. Only what AudioSynthWavetable touches is here.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+
+#define HOST_BUILD 1
+
+typedef uint8_t byte;
+
+// There is no audio interrupt on the host; update() is driven synchronously
+// by AudioStream::update_all(), so interrupt masking is a no-op.
+static inline void cli(void) {}
+static inline void sei(void) {}
+#define __disable_irq() cli()
+#define __enable_irq() sei()
+
+uint32_t micros(void);
+uint32_t millis(void);
+
+// Serial output is discarded until begin() is called, so the library's debug
+// printing does not end up in the timing of an offline render.
+class HostSerial
+{
+public:
+	void begin(uint32_t baud) { (void)baud; enabled = true; }
+	void end(void) { enabled = false; }
+	int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+		if (!enabled) return 0;
+		va_list args;
+		va_start(args, format);
+		int n = vfprintf(stderr, format, args);
+		va_end(args);
+		return n;
+	}
+	void print(const char* s) { if (enabled) fputs(s, stderr); }
+	void print(int v) { if (enabled) fprintf(stderr, "%d", v); }
+	void println(const char* s = "") { if (enabled) fprintf(stderr, "%s\n", s); }
+	void println(int v) { if (enabled) fprintf(stderr, "%d\n", v); }
+private:
+	bool enabled = false;
+};
+
+extern HostSerial Serial;
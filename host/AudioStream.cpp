@@ -0,0 +1,207 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "AudioStream.h"
+#include <chrono>
+
+HostSerial Serial;
+
+static const std::chrono::steady_clock::time_point host_start = std::chrono::steady_clock::now();
+
+uint32_t micros(void) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - host_start).count();
+}
+
+uint32_t millis(void) {
+	return micros() / 1000;
+}
+
+audio_block_t * AudioStream::memory_pool = NULL;
+audio_block_t ** AudioStream::memory_free_list = NULL;
+uint16_t AudioStream::memory_pool_size = 0;
+uint16_t AudioStream::memory_free_count = 0;
+uint16_t AudioStream::memory_used = 0;
+uint16_t AudioStream::memory_used_max = 0;
+uint32_t AudioStream::cpu_cycles_total = 0;
+uint32_t AudioStream::cpu_cycles_total_max = 0;
+AudioStream * AudioStream::first_update = NULL;
+
+AudioStream::AudioStream(unsigned char ninput, audio_block_t **iqueue) :
+	num_inputs(ninput), inputQueue(iqueue)
+{
+	active = false;
+	destination_list = NULL;
+	for (int i = 0; i < num_inputs; i++) inputQueue[i] = NULL;
+	// add to a simple list, for update_all
+	AudioStream *p;
+	if (first_update == NULL) {
+		first_update = this;
+	} else {
+		for (p = first_update; p->next_update; p = p->next_update) ;
+		p->next_update = this;
+	}
+	next_update = NULL;
+	cpu_cycles = 0;
+	cpu_cycles_max = 0;
+	numConnections = 0;
+}
+
+AudioStream::~AudioStream()
+{
+	AudioStream **pp;
+	for (pp = &first_update; *pp; pp = &(*pp)->next_update) {
+		if (*pp == this) {
+			*pp = next_update;
+			break;
+		}
+	}
+}
+
+// Set up the pool of audio data blocks
+void AudioStream::initialize_memory(audio_block_t *data, unsigned int num)
+{
+	delete[] memory_free_list;
+	memory_pool = data;
+	memory_pool_size = num;
+	memory_free_list = new audio_block_t*[num];
+	for (unsigned int i = 0; i < num; i++) {
+		data[i].memory_pool_index = i;
+		memory_free_list[i] = &data[num - 1 - i];
+	}
+	memory_free_count = num;
+	memory_used = memory_used_max = 0;
+}
+
+// Allocate 1 audio data block.  If successful
+// the caller is the only owner of this new block
+audio_block_t * AudioStream::allocate(void)
+{
+	if (memory_free_count == 0) return NULL;
+	audio_block_t *block = memory_free_list[--memory_free_count];
+	block->ref_count = 1;
+	if (++memory_used > memory_used_max) memory_used_max = memory_used;
+	return block;
+}
+
+// Release ownership of a data block.  If no
+// other streams have ownership, the block is
+// returned to the free pool
+void AudioStream::release(audio_block_t *block)
+{
+	if (block->ref_count > 1) {
+		block->ref_count--;
+	} else {
+		memory_free_list[memory_free_count++] = block;
+		memory_used--;
+	}
+}
+
+// Transmit an audio data block
+// to all streams that connect to an output.  The block
+// becomes owned by all the recepients, but also is still
+// owned by this object.  Normally, a block must be released
+// by the caller after it's transmitted.  This allows the
+// caller to transmit to same block to more than 1 output,
+// and then release it once after all transmit calls.
+void AudioStream::transmit(audio_block_t *block, unsigned char index)
+{
+	for (AudioConnection *c = destination_list; c != NULL; c = c->next_dest) {
+		if (c->src_index == index) {
+			if (c->dst.inputQueue[c->dest_index] == NULL) {
+				c->dst.inputQueue[c->dest_index] = block;
+				block->ref_count++;
+			}
+		}
+	}
+}
+
+// Receive block from an input.  The block's data
+// may be shared with other streams, so it must not be written
+audio_block_t * AudioStream::receiveReadOnly(unsigned int index)
+{
+	audio_block_t *in;
+
+	if (index >= num_inputs) return NULL;
+	in = inputQueue[index];
+	inputQueue[index] = NULL;
+	return in;
+}
+
+// Receive block from an input.  The block will not
+// be shared, so its contents may be changed.
+audio_block_t * AudioStream::receiveWritable(unsigned int index)
+{
+	audio_block_t *in, *p;
+
+	if (index >= num_inputs) return NULL;
+	in = inputQueue[index];
+	inputQueue[index] = NULL;
+	if (in && in->ref_count > 1) {
+		p = allocate();
+		if (p) memcpy(p->data, in->data, sizeof(p->data));
+		in->ref_count--;
+		in = p;
+	}
+	return in;
+}
+
+void AudioConnection::connect(void)
+{
+	AudioConnection *p;
+
+	if (dest_index > dst.num_inputs) return;
+	p = src.destination_list;
+	if (p == NULL) {
+		src.destination_list = this;
+	} else {
+		while (p->next_dest) p = p->next_dest;
+		p->next_dest = this;
+	}
+	src.active = true;
+	dst.active = true;
+}
+
+void AudioStream::update_all(void)
+{
+	AudioStream *p;
+	uint32_t totalcycles = 0;
+
+	for (p = AudioStream::first_update; p; p = p->next_update) {
+		if (p->active) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			p->update();
+			uint32_t cycles = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+			p->cpu_cycles = cycles;
+			if (cycles > p->cpu_cycles_max) p->cpu_cycles_max = cycles;
+			totalcycles += cycles;
+		}
+	}
+	AudioStream::cpu_cycles_total = totalcycles;
+	if (totalcycles > AudioStream::cpu_cycles_total_max)
+		AudioStream::cpu_cycles_total_max = totalcycles;
+}
@@ -0,0 +1,342 @@
+#include "SawLayers_samples.h"
+constexpr sample_data SawLayers_samples[3] = {
+	{
+		sample_0_SawLayers_SoftSaw + 4,	//16-bit PCM encoded audio sample, after the guard samples
+		true,	//Whether or not to loop this sample
+		11,	//Number of bits needed to hold length
+		(2097152*1.0*(44000.0 / AUDIO_SAMPLE_RATE_EXACT)) / 440.0,	//((0x80000000 >> (index_bits - 1)) * cents_offset * sampling_rate / AUDIO_SAME_RATE_EXACT) / sample_freq
+		((uint32_t)1100-1) << (32 - 11),	//(sample_length-1) << (32 - sample_length_bits)
+		((uint32_t)1001-1) << (32 - 11),	//(loop_end-1) << (32 - sample_length_bits) == LOOP_PHASE_END
+		(((uint32_t)1001-1) << (32 - 11)) - (((uint32_t)101-1) << (32 - 11)),	//LOOP_PHASE_END - (loop_start-1) << (32 - sample_length_bits) == LOOP_PHASE_END - LOOP_PHASE_START == LOOP_PHASE_LENGTH
+		uint16_t(UINT16_MAX * DECIBEL_SHIFT(-0/100.0)), //INITIAL_ATTENUATION_SCALAR
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DELAY_COUNT
+		uint32_t(5*SAMPLES_PER_MSEC/8.0+0.5),	//ATTACK_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//HOLD_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DECAY_COUNT
+		uint32_t(100*SAMPLES_PER_MSEC/8.0+0.5),	//RELEASE_COUNT
+		int32_t(0.0*UNITY_GAIN),	//SUSTAIN_MULT
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), 	// VIBRATO_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // VIBRATO_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // VIBRATO_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // VIBRATO_COEFFICIENT_SECONDARY
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), // MODULATION_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // MODULATION_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // MODULATION_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // MODULATION_PITCH_COEFFICIENT_SECOND
+		int32_t(UINT16_MAX * (DECIBEL_SHIFT(-0.1) - 1.0)) *4, // MODULATION_AMPLITUDE_INITIAL_GAIN
+		int32_t(UINT16_MAX * (1.0 - DECIBEL_SHIFT(0.1))) *4, // MODULATION_AMPLITUDE_FINAL_GAIN
+		0,	//Number of band-limited copies, each decimated by a further octave
+		NULL,	//Band-limited copies
+		4,	//Guard samples before the start and after the loop end or end
+	},
+	{
+		sample_1_SawLayers_BrightSaw + 4,	//16-bit PCM encoded audio sample, after the guard samples
+		true,	//Whether or not to loop this sample
+		11,	//Number of bits needed to hold length
+		(2097152*1.0*(44000.0 / AUDIO_SAMPLE_RATE_EXACT)) / 440.0,	//((0x80000000 >> (index_bits - 1)) * cents_offset * sampling_rate / AUDIO_SAME_RATE_EXACT) / sample_freq
+		((uint32_t)1100-1) << (32 - 11),	//(sample_length-1) << (32 - sample_length_bits)
+		((uint32_t)1001-1) << (32 - 11),	//(loop_end-1) << (32 - sample_length_bits) == LOOP_PHASE_END
+		(((uint32_t)1001-1) << (32 - 11)) - (((uint32_t)101-1) << (32 - 11)),	//LOOP_PHASE_END - (loop_start-1) << (32 - sample_length_bits) == LOOP_PHASE_END - LOOP_PHASE_START == LOOP_PHASE_LENGTH
+		uint16_t(UINT16_MAX * DECIBEL_SHIFT(-0/100.0)), //INITIAL_ATTENUATION_SCALAR
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DELAY_COUNT
+		uint32_t(5*SAMPLES_PER_MSEC/8.0+0.5),	//ATTACK_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//HOLD_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DECAY_COUNT
+		uint32_t(100*SAMPLES_PER_MSEC/8.0+0.5),	//RELEASE_COUNT
+		int32_t(0.0*UNITY_GAIN),	//SUSTAIN_MULT
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), 	// VIBRATO_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // VIBRATO_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // VIBRATO_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // VIBRATO_COEFFICIENT_SECONDARY
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), // MODULATION_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // MODULATION_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // MODULATION_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // MODULATION_PITCH_COEFFICIENT_SECOND
+		int32_t(UINT16_MAX * (DECIBEL_SHIFT(-0.1) - 1.0)) *4, // MODULATION_AMPLITUDE_INITIAL_GAIN
+		int32_t(UINT16_MAX * (1.0 - DECIBEL_SHIFT(0.1))) *4, // MODULATION_AMPLITUDE_FINAL_GAIN
+		0,	//Number of band-limited copies, each decimated by a further octave
+		NULL,	//Band-limited copies
+		4,	//Guard samples before the start and after the loop end or end
+	},
+	{
+		sample_2_SawLayers_HighSaw + 4,	//16-bit PCM encoded audio sample, after the guard samples
+		true,	//Whether or not to loop this sample
+		11,	//Number of bits needed to hold length
+		(2097152*1.0*(44000.0 / AUDIO_SAMPLE_RATE_EXACT)) / 440.0,	//((0x80000000 >> (index_bits - 1)) * cents_offset * sampling_rate / AUDIO_SAME_RATE_EXACT) / sample_freq
+		((uint32_t)1100-1) << (32 - 11),	//(sample_length-1) << (32 - sample_length_bits)
+		((uint32_t)1001-1) << (32 - 11),	//(loop_end-1) << (32 - sample_length_bits) == LOOP_PHASE_END
+		(((uint32_t)1001-1) << (32 - 11)) - (((uint32_t)101-1) << (32 - 11)),	//LOOP_PHASE_END - (loop_start-1) << (32 - sample_length_bits) == LOOP_PHASE_END - LOOP_PHASE_START == LOOP_PHASE_LENGTH
+		uint16_t(UINT16_MAX * DECIBEL_SHIFT(-0/100.0)), //INITIAL_ATTENUATION_SCALAR
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DELAY_COUNT
+		uint32_t(5*SAMPLES_PER_MSEC/8.0+0.5),	//ATTACK_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//HOLD_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DECAY_COUNT
+		uint32_t(100*SAMPLES_PER_MSEC/8.0+0.5),	//RELEASE_COUNT
+		int32_t(0.0*UNITY_GAIN),	//SUSTAIN_MULT
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), 	// VIBRATO_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // VIBRATO_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // VIBRATO_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // VIBRATO_COEFFICIENT_SECONDARY
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), // MODULATION_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // MODULATION_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // MODULATION_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // MODULATION_PITCH_COEFFICIENT_SECOND
+		int32_t(UINT16_MAX * (DECIBEL_SHIFT(-0.1) - 1.0)) *4, // MODULATION_AMPLITUDE_INITIAL_GAIN
+		int32_t(UINT16_MAX * (1.0 - DECIBEL_SHIFT(0.1))) *4, // MODULATION_AMPLITUDE_FINAL_GAIN
+		0,	//Number of band-limited copies, each decimated by a further octave
+		NULL,	//Band-limited copies
+		4,	//Guard samples before the start and after the loop end or end
+	},
+};
+static_assert(sample_data_valid(SawLayers_samples[0]), "sample 0 of SawLayers");
+static_assert(sample_data_valid(SawLayers_samples[1]), "sample 1 of SawLayers");
+static_assert(sample_data_valid(SawLayers_samples[2]), "sample 2 of SawLayers");
+
+constexpr int16_t sample_0_SawLayers_SoftSaw[1280] __attribute__((aligned(16))) = {
+0,0,0,0,0,3001,5914,8654,11146,13324,15138,16554,17554,18139,18327,18152,
+17661,16909,15963,14887,13751,12616,11539,10567,9735,9065,8565,8233,8053,8000,8041,8139,
+8255,8350,8388,8341,8187,7913,7516,7001,6384,5685,4932,4156,3388,2658,1993,1414,
+935,564,299,129,39,5,0,-5,-39,-129,-299,-564,-935,-1414,-1993,-2658,
+-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,
+-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,
+-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,0,3001,5914,8654,11146,13324,15138,16554,
+17554,18139,18327,18152,17661,16909,15963,14887,13751,12616,11539,10567,9735,9065,8565,8233,
+8053,8000,8041,8139,8255,8350,8388,8341,8187,7913,7516,7001,6384,5685,4932,4156,
+3388,2658,1993,1414,935,564,299,129,39,5,0,-5,-39,-129,-299,-564,
+-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,
+-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,
+-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,0,3001,5914,8654,
+11146,13324,15138,16554,17554,18139,18327,18152,17661,16909,15963,14887,13751,12616,11539,10567,
+9735,9065,8565,8233,8053,8000,8041,8139,8255,8350,8388,8341,8187,7913,7516,7001,
+6384,5685,4932,4156,3388,2658,1993,1414,935,564,299,129,39,5,0,-5,
+-39,-129,-299,-564,-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,
+-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,
+-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,
+0,3001,5914,8654,11146,13324,15138,16554,17554,18139,18327,18152,17661,16909,15963,14887,
+13751,12616,11539,10567,9735,9065,8565,8233,8053,8000,8041,8139,8255,8350,8388,8341,
+8187,7913,7516,7001,6384,5685,4932,4156,3388,2658,1993,1414,935,564,299,129,
+39,5,0,-5,-39,-129,-299,-564,-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,
+-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,
+-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,
+-11146,-8654,-5914,-3001,0,3001,5914,8654,11146,13324,15138,16554,17554,18139,18327,18152,
+17661,16909,15963,14887,13751,12616,11539,10567,9735,9065,8565,8233,8053,8000,8041,8139,
+8255,8350,8388,8341,8187,7913,7516,7001,6384,5685,4932,4156,3388,2658,1993,1414,
+935,564,299,129,39,5,0,-5,-39,-129,-299,-564,-935,-1414,-1993,-2658,
+-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,
+-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,
+-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,0,3001,5914,8654,11146,13324,15138,16554,
+17554,18139,18327,18152,17661,16909,15963,14887,13751,12616,11539,10567,9735,9065,8565,8233,
+8053,8000,8041,8139,8255,8350,8388,8341,8187,7913,7516,7001,6384,5685,4932,4156,
+3388,2658,1993,1414,935,564,299,129,39,5,0,-5,-39,-129,-299,-564,
+-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,
+-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,
+-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,0,3001,5914,8654,
+11146,13324,15138,16554,17554,18139,18327,18152,17661,16909,15963,14887,13751,12616,11539,10567,
+9735,9065,8565,8233,8053,8000,8041,8139,8255,8350,8388,8341,8187,7913,7516,7001,
+6384,5685,4932,4156,3388,2658,1993,1414,935,564,299,129,39,5,0,-5,
+-39,-129,-299,-564,-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,
+-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,
+-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,
+0,3001,5914,8654,11146,13324,15138,16554,17554,18139,18327,18152,17661,16909,15963,14887,
+13751,12616,11539,10567,9735,9065,8565,8233,8053,8000,8041,8139,8255,8350,8388,8341,
+8187,7913,7516,7001,6384,5685,4932,4156,3388,2658,1993,1414,935,564,299,129,
+39,5,0,-5,-39,-129,-299,-564,-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,
+-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,
+-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,
+-11146,-8654,-5914,-3001,0,3001,5914,8654,11146,13324,15138,16554,17554,18139,18327,18152,
+17661,16909,15963,14887,13751,12616,11539,10567,9735,9065,8565,8233,8053,8000,8041,8139,
+8255,8350,8388,8341,8187,7913,7516,7001,6384,5685,4932,4156,3388,2658,1993,1414,
+935,564,299,129,39,5,0,-5,-39,-129,-299,-564,-935,-1414,-1993,-2658,
+-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,
+-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,
+-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,0,3001,5914,8654,11146,13324,15138,16554,
+17554,18139,18327,18152,17661,16909,15963,14887,13751,12616,11539,10567,9735,9065,8565,8233,
+8053,8000,8041,8139,8255,8350,8388,8341,8187,7913,7516,7001,6384,5685,4932,4156,
+3388,2658,1993,1414,935,564,299,129,39,5,0,-5,-39,-129,-299,-564,
+-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,-8187,-8341,-8388,-8350,
+-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,-13751,-14887,-15963,-16909,
+-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,0,3001,5914,8654,
+11146,13324,15138,16554,17554,18139,18327,18152,17661,16909,15963,14887,13751,12616,11539,10567,
+9735,9065,8565,8233,8053,8000,8041,8139,8255,8350,8388,8341,8187,7913,7516,7001,
+6384,5685,4932,4156,3388,2658,1993,1414,935,564,299,129,39,5,0,-5,
+-39,-129,-299,-564,-935,-1414,-1993,-2658,-3388,-4156,-4932,-5685,-6384,-7001,-7516,-7913,
+-8187,-8341,-8388,-8350,-8255,-8139,-8041,-8000,-8053,-8233,-8565,-9065,-9735,-10567,-11539,-12616,
+-13751,-14887,-15963,-16909,-17661,-18152,-18327,-18139,-17554,-16554,-15138,-13324,-11146,-8654,-5914,-3001,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr int16_t sample_1_SawLayers_BrightSaw[1280] __attribute__((aligned(16))) = {
+0,0,0,0,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr int16_t sample_2_SawLayers_HighSaw[1280] __attribute__((aligned(16))) = {
+0,0,0,0,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
@@ -0,0 +1,626 @@
+#include "SawMip_samples.h"
+constexpr sample_data SawMip_samples[1] = {
+	{
+		sample_0_SawMip_BrightSaw + 4,	//16-bit PCM encoded audio sample, after the guard samples
+		true,	//Whether or not to loop this sample
+		13,	//Number of bits needed to hold length
+		(524288*1.0*(44000.0 / AUDIO_SAMPLE_RATE_EXACT)) / 440.0,	//((0x80000000 >> (index_bits - 1)) * cents_offset * sampling_rate / AUDIO_SAME_RATE_EXACT) / sample_freq
+		((uint32_t)4100-1) << (32 - 13),	//(sample_length-1) << (32 - sample_length_bits)
+		((uint32_t)4001-1) << (32 - 13),	//(loop_end-1) << (32 - sample_length_bits) == LOOP_PHASE_END
+		(((uint32_t)4001-1) << (32 - 13)) - (((uint32_t)101-1) << (32 - 13)),	//LOOP_PHASE_END - (loop_start-1) << (32 - sample_length_bits) == LOOP_PHASE_END - LOOP_PHASE_START == LOOP_PHASE_LENGTH
+		uint16_t(UINT16_MAX * DECIBEL_SHIFT(-0/100.0)), //INITIAL_ATTENUATION_SCALAR
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DELAY_COUNT
+		uint32_t(5*SAMPLES_PER_MSEC/8.0+0.5),	//ATTACK_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//HOLD_COUNT
+		uint32_t(0*SAMPLES_PER_MSEC/8.0+0.5),	//DECAY_COUNT
+		uint32_t(100*SAMPLES_PER_MSEC/8.0+0.5),	//RELEASE_COUNT
+		int32_t(0.0*UNITY_GAIN),	//SUSTAIN_MULT
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), 	// VIBRATO_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // VIBRATO_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // VIBRATO_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // VIBRATO_COEFFICIENT_SECONDARY
+		uint32_t(0 * SAMPLES_PER_MSEC / (2 * LFO_PERIOD)), // MODULATION_DELAY
+		uint32_t(0/1000.0 * LFO_PERIOD * (UINT32_MAX / AUDIO_SAMPLE_RATE_EXACT)), // MODULATION_INCREMENT
+		(CENTS_SHIFT(-0/1000.0) - 1.0)*4, // MODULATION_PITCH_COEFFICIENT_INITIAL
+		(1.0 - CENTS_SHIFT(0/1000.0))*4, // MODULATION_PITCH_COEFFICIENT_SECOND
+		int32_t(UINT16_MAX * (DECIBEL_SHIFT(-0.1) - 1.0)) *4, // MODULATION_AMPLITUDE_INITIAL_GAIN
+		int32_t(UINT16_MAX * (1.0 - DECIBEL_SHIFT(0.1))) *4, // MODULATION_AMPLITUDE_FINAL_GAIN
+		4,	//Number of band-limited copies, each decimated by a further octave
+		sample_0_SawMip_BrightSaw_mips,	//Band-limited copies
+		4,	//Guard samples before the start and after the loop end or end
+	},
+};
+static_assert(sample_data_valid(SawMip_samples[0]), "sample 0 of SawMip");
+
+constexpr int16_t sample_0_SawMip_BrightSaw[4352] __attribute__((aligned(16))) = {
+0,0,0,0,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,
+16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,
+9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,
+3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,
+-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,
+-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,
+-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,21686,16579,18509,
+16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,12864,12470,11969,11833,
+11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,6931,6256,6179,5523,
+5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,683,414,0,-414,
+-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,
+-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,
+-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,
+0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,14670,13668,13778,13069,
+12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,8306,7859,7637,7036,
+6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,2129,2017,1388,1230,
+683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,-3727,-4152,-4559,-4828,
+-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,-9634,-10373,-10349,-11136,
+-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,-16188,-15945,-16715,-17039,
+-16979,-18509,-16579,-21686,0,21686,16579,18509,16979,17039,16715,15945,16188,15057,15489,14314,
+14670,13668,13778,13069,12864,12470,11969,11833,11126,11136,10349,10373,9634,9555,8962,8707,
+8306,7859,7637,7036,6931,6256,6179,5523,5384,4828,4559,4152,3727,3470,2911,2763,
+2129,2017,1388,1230,683,414,0,-414,-683,-1230,-1388,-2017,-2129,-2763,-2911,-3470,
+-3727,-4152,-4559,-4828,-5384,-5523,-6179,-6256,-6931,-7036,-7637,-7859,-8306,-8707,-8962,-9555,
+-9634,-10373,-10349,-11136,-11126,-11833,-11969,-12470,-12864,-13069,-13778,-13668,-14670,-14314,-15489,-15057,
+-16188,-15945,-16715,-17039,-16979,-18509,-16579,-21686,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr int16_t sample_0_SawMip_BrightSaw_mip1[2304] __attribute__((aligned(16))) = {
+134,-361,804,-1725,5991,19311,17067,16557,15938,14990,14373,13554,12820,12064,11309,10556,
+9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,
+-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,
+-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,
+11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,
+-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,
+-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,
+12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,
+754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,
+-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,
+14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,
+2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,
+-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,
+15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,
+3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,
+-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,
+16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,
+5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,
+-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,
+0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,
+6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,
+-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,
+-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,
+8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,
+-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,
+-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,
+9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,
+-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,
+-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,
+11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,
+-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,
+-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,
+12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,
+754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,
+-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,
+14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,
+2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,
+-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,
+15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,
+3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,
+-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,
+16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,
+5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,
+-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,
+0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,
+6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,
+-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,
+-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,
+8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,
+-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,
+-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,
+9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,
+-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,
+-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,
+11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,
+-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,
+-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,
+12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,
+754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,
+-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,
+14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,
+2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,
+-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,
+15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,
+3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,
+-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,
+16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,
+5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,
+-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,
+0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,
+6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,
+-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,
+-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,
+8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,
+-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,
+-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,
+9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,
+-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,
+-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,
+11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,
+-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,
+-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,
+12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,
+754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,
+-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,
+14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,
+2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,
+-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,
+15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,
+3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,
+-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,
+16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,
+5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,
+-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,
+0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,
+6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,
+-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,
+-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,
+8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,
+-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,
+-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,
+9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,
+-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,
+-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,
+11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,
+-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,
+-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,
+12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,
+754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,
+-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,
+14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,
+2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,
+-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,
+15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,5278,4524,
+3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,
+-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,0,21036,
+16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,6785,6031,
+5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,-5278,-6031,
+-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,-16263,-21036,
+0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,8294,7540,
+6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,-3770,-4524,
+-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,-15804,-16918,
+-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,9802,9047,
+8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,-2262,-3016,
+-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,-14373,-15020,
+-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,15020,14373,13548,12820,12064,11309,10556,
+9802,9047,8294,7540,6785,6031,5278,4524,3770,3016,2262,1508,754,0,-754,-1508,
+-2262,-3016,-3770,-4524,-5278,-6031,-6785,-7540,-8294,-9047,-9802,-10556,-11309,-12064,-12820,-13548,
+-14373,-15020,-15804,-16918,-16263,-21036,0,21036,16263,16918,15804,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr int16_t sample_0_SawMip_BrightSaw_mip2[1280] __attribute__((aligned(16))) = {
+60,-240,643,-1588,7624,18680,15420,14401,12855,11257,9831,8282,6786,5278,3770,2262,
+754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,
+14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,
+-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,
+3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,
+20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,
+-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,
+6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,
+-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,
+-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,
+9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,
+-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,
+-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,
+12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,
+-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,
+2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,
+14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,
+-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,
+5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,
+0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,
+-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,
+8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,
+-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,
+-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,
+11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,
+-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,
+754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,
+14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,
+-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,
+3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,
+20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,
+-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,
+6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,
+-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,
+-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,
+9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,
+-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,
+-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,
+12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,
+-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,
+2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,
+14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,
+-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,
+5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,
+0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,
+-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,
+8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,
+-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,
+-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,
+11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,
+-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,
+754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,
+14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,
+-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,
+3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,
+20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,
+-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,
+6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,
+-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,
+-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,11253,
+9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,
+-14641,-14776,-20268,0,20268,14776,14641,12795,11253,9843,8275,6786,5278,3770,2262,754,
+-754,-2262,-3770,-5278,-6786,-8275,-9843,-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,
+12795,11253,9843,8275,6786,5278,3770,2262,754,-754,-2262,-3770,-5278,-6786,-8275,-9843,
+-11253,-12795,-14641,-14776,-20268,0,20268,14776,14641,12795,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr int16_t sample_0_SawMip_BrightSaw_mip3[768] __attribute__((aligned(16))) = {
+24,-177,550,-1472,8271,17282,12321,9931,6791,3735,797,-2362,-5014,-8852,-10328,-15899,
+-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,
+10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,
+-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,
+-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,
+18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,
+5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,
+-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,
+-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,
+10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,
+814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,
+-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,
+13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,
+6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,
+-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,
+-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,
+11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,
+2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,
+-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,
+0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,
+8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,
+-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,
+-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,
+15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,
+3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,
+-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,
+-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,
+10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,
+-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,-5014,-8852,
+-10328,-15899,-13616,13616,15899,10328,8852,5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,
+18753,11772,10108,6766,3716,814,-2369,-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,
+5014,2369,-814,-3716,-6766,-10108,-11772,-18753,0,18753,11772,10108,6766,3716,814,-2369,
+-5014,-8852,-10328,-15899,-13616,13616,15899,10328,8852,5014,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr int16_t sample_0_SawMip_BrightSaw_mip4[512] __attribute__((aligned(16))) = {
+-1,-130,474,-1352,8329,14330,6435,327,-3956,-14192,-6694,15096,8583,1408,-2508,-11553,
+-12010,12010,11553,2508,-1408,-8583,-15090,6676,14220,3955,-458,-5961,-15682,0,15682,5961,
+458,-3955,-14220,-6676,15090,8583,1408,-2508,-11553,-12010,12010,11553,2508,-1408,-8583,-15090,
+6676,14220,3955,-458,-5961,-15682,0,15682,5961,458,-3955,-14220,-6676,15090,8583,1408,
+-2508,-11553,-12010,12010,11553,2508,-1408,-8583,-15090,6676,14220,3955,-458,-5961,-15682,0,
+15682,5961,458,-3955,-14220,-6676,15090,8583,1408,-2508,-11553,-12010,12010,11553,2508,-1408,
+-8583,-15090,6676,14220,3955,-458,-5961,-15682,0,15682,5961,458,-3955,-14220,-6676,15090,
+8583,1408,-2508,-11553,-12010,12010,11553,2508,-1408,-8583,-15090,6676,14220,3955,-458,-5961,
+-15682,0,15682,5961,458,-3955,-14220,-6676,15090,8583,1408,-2508,-11553,-12010,12010,11553,
+2508,-1408,-8583,-15090,6676,14220,3955,-458,-5961,-15682,0,15682,5961,458,-3955,-14220,
+-6676,15090,8583,1408,-2508,-11553,-12010,12010,11553,2508,-1408,-8583,-15090,6676,14220,3955,
+-458,-5961,-15682,0,15682,5961,458,-3955,-14220,-6676,15090,8583,1408,-2508,-11553,-12010,
+12010,11553,2508,-1408,-8583,-15090,6676,14220,3955,-458,-5961,-15682,0,15682,5961,458,
+-3955,-14220,-6676,15090,8583,1408,-2508,-11553,-12010,12010,11553,2508,-1408,-8583,-15090,6676,
+14220,3955,-458,-5961,-15682,0,15682,5961,458,-3955,-14220,-6676,15090,8583,1408,-2508,
+-11553,-12010,12010,11553,2508,-1408,-8583,-15090,6676,14220,3955,-458,-5961,-15682,0,15682,
+5961,458,-3955,-14220,-6676,15090,8583,1408,-2508,-11553,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr const int16_t* sample_0_SawMip_BrightSaw_mips[4] = {sample_0_SawMip_BrightSaw_mip1 + 4, sample_0_SawMip_BrightSaw_mip2 + 4, sample_0_SawMip_BrightSaw_mip3 + 4, sample_0_SawMip_BrightSaw_mip4 + 4};
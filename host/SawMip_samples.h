@@ -0,0 +1,28 @@
+#pragma once
+#include <AudioStream.h>
+#include <AudioSynthWavetable.h>
+
+extern const sample_data SawMip_samples[1];
+const uint8_t SawMip_ranges[] = {127, };
+
+const uint8_t SawMip_notes[NOTE_COUNT * 1] = {
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr instrument_data SawMip = {1, SawMip_ranges, SawMip_samples, SawMip_notes, 1, NULL };
+
+
+extern const int16_t sample_0_SawMip_BrightSaw[4352];
+
+extern const int16_t sample_0_SawMip_BrightSaw_mip1[2304];
+
+extern const int16_t sample_0_SawMip_BrightSaw_mip2[1280];
+
+extern const int16_t sample_0_SawMip_BrightSaw_mip3[768];
+
+extern const int16_t sample_0_SawMip_BrightSaw_mip4[512];
+
+extern const int16_t* const sample_0_SawMip_BrightSaw_mips[4];
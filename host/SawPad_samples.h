@@ -0,0 +1,18 @@
+#pragma once
+#include <AudioStream.h>
+#include <AudioSynthWavetable.h>
+
+extern const sample_data SawPad_samples[1];
+const uint8_t SawPad_ranges[] = {127, };
+
+const uint8_t SawPad_notes[NOTE_COUNT * 1] = {
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr instrument_data SawPad = {1, SawPad_ranges, SawPad_samples, SawPad_notes, 1, NULL };
+
+
+extern const int16_t sample_0_SawPad_BrightSaw[4352];
@@ -0,0 +1,18 @@
+#pragma once
+#include <AudioStream.h>
+#include <AudioSynthWavetable.h>
+
+extern const sample_data Saw_samples[1];
+const uint8_t Saw_ranges[] = {127, };
+
+const uint8_t Saw_notes[NOTE_COUNT * 1] = {
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+constexpr instrument_data Saw = {1, Saw_ranges, Saw_samples, Saw_notes, 1, NULL };
+
+
+extern const int16_t sample_0_Saw_BrightSaw[4352];
@@ -0,0 +1,3 @@
+// Empty stand-in for the SerialFlash library header; nothing from it is used
+// by the host build.
+#pragma once
@@ -0,0 +1,655 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Microbenchmarks for the AudioSynthWavetable inner loops on the host.
+//
+//   wavetable_bench [-i instrument] [-n blocks] [suite ...]
+//
+// Suites (all of them run by default):
+//
+// kernels: renders blocks of every instrument sample through each
+// interpolation kernel the CPU supports, checks the output is bit-identical
+// to the scalar kernel and reports ns/block and the speedup over scalar.
+// Exits nonzero if any kernel disagrees with the scalar one.
+//
+// modes: for each interpolation mode, the cost per output sample (ns and,
+// on x86, TSC cycles) reading a sample with guard samples, the cycles with
+// per-tap bounds checks instead, and the SNR against the exact band-limited
+// signal when a three-tone test sample is replayed an octave down, a fifth
+// down and a third up.
+//
+// voice: renders notes of each instrument through AudioSynthWavetable::render()
+// with every supported kernel, retriggering and releasing them so the blocks
+// cover each envelope stage, and reports ns per voice-block and, on x86, TSC
+// cycles per sample.
+//
+// variants: groups each instrument's samples by the render loop variant that
+// plays them ({loop, one-shot} x vibrato x modulation, see
+// AudioSynthWavetable::renderVariant()) and, for notes on each group, reports
+// TSC cycles per sample through the specialized loop and through the
+// generic one with both LFOs.
+//
+// mips: plays notes an octave apart on the synthetic Saw instrument and on
+// SawMip, the same sample decoded with 4 mip levels, and reports for each
+// the harmonic-to-alias ratio of the output and the ns per voice-block.
+//
+// voices: a storm of note-ons and note-offs on 16 channels (16 events per
+// block, the voices rendered in between) through the linear-scan allocator
+// of the MidiSynthKeyboard example and through WavetableVoiceManager, with
+// 64 and 256 voices; reports ns per event, allocation alone.
+//
+// idle: 64 standalone voices, each connected to a mixing sink as in the
+// examples, holding chords of 0, 8 and 32 notes; reports ns per block of
+// AudioStream::update_all() with idle voices updated every block and with
+// them parked (see AudioSynthWavetable::parkIdle()).
+
+#include "AudioSynthWavetable.h"
+#include "AudioSynthWavetablePoly.h"
+#include "WavetableVoiceManager.h"
+#include "instruments.h"
+#include "wavetable_kernels.h"
+#include <chrono>
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <unistd.h>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC
+#endif
+
+struct bench_voice {
+	const sample_data* sample;
+	uint32_t phase;
+	uint32_t incr;
+	uint32_t phase_limit;
+};
+
+// one voice per instrument sample, each at a different pitch, wrapping the
+// phase so that no block crosses the end of the sample
+static void make_voices(const instrument_data* instrument, std::vector<bench_voice>& voices) {
+	for (int i = 0; i < instrument->sample_count; ++i) {
+		const sample_data* s = &instrument->samples[i];
+		uint32_t end = s->LOOP ? s->LOOP_PHASE_END : s->MAX_PHASE;
+		for (int note = 36; note < 96; note += 7) {
+			float freq = 440.0 * powf(2.0, (note - 69) / 12.0);
+			uint32_t incr = freq * s->PER_HERTZ_PHASE_INCREMENT;
+			if (incr == 0 || (uint64_t)incr * AUDIO_BLOCK_SAMPLES >= end) continue;
+			bench_voice v = { s, 0, incr, end - incr * AUDIO_BLOCK_SAMPLES };
+			voices.push_back(v);
+		}
+	}
+}
+
+static double run_kernel(std::vector<bench_voice> voices, int blocks, std::vector<int16_t>& out) {
+	out.assign((size_t)blocks * AUDIO_BLOCK_SAMPLES, 0);
+	auto start = std::chrono::steady_clock::now();
+	for (int b = 0; b < blocks; ++b) {
+		bench_voice& v = voices[b % voices.size()];
+		wavetable_interpolate(&out[(size_t)b * AUDIO_BLOCK_SAMPLES], AUDIO_BLOCK_SAMPLES,
+			v.phase, v.incr, v.sample->sample, v.sample->INDEX_BITS, 0x7FFF);
+		v.phase += v.incr * AUDIO_BLOCK_SAMPLES;
+		if (v.phase >= v.phase_limit) v.phase -= v.phase_limit;
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return seconds * 1e9 / blocks;
+}
+
+static bool bench_kernels(const instrument_data* instrument, int blocks) {
+	std::vector<bench_voice> voices;
+	make_voices(instrument, voices);
+	if (voices.empty()) return true;
+
+	wavetableKernelEnum initial = wavetable_selected_kernel();
+	std::vector<int16_t> reference, out;
+	wavetable_select_kernel(KERNEL_SCALAR);
+	run_kernel(voices, blocks / 10 + 1, reference);
+	double scalar_ns = run_kernel(voices, blocks, reference);
+
+	bool ok = true;
+	for (int k = 0; k < KERNEL_COUNT; ++k) {
+		if (!wavetable_select_kernel((wavetableKernelEnum)k)) continue;
+		run_kernel(voices, blocks / 10 + 1, out);
+		double ns = run_kernel(voices, blocks, out);
+		bool same = out == reference;
+		ok = ok && same;
+		printf("  %-8s %8.1f ns/block %6.2fx %s\n", wavetable_kernel_name((wavetableKernelEnum)k),
+			ns, scalar_ns / ns, same ? "bit-identical" : "MISMATCH");
+	}
+	wavetable_select_kernel(initial);
+	return ok;
+}
+
+// test sample for the modes suite: three tones at 2%, 11% and 23% of the
+// sample rate, 16 bits of index
+#define TEST_INDEX_BITS 16
+#define TEST_LENGTH (1 << TEST_INDEX_BITS)
+static const double test_freqs[] = { 0.02, 0.11, 0.23 };
+static const double test_amps[] = { 9000, 9000, 9000 };
+
+static double test_signal(double pos) {
+	double v = 0;
+	for (int i = 0; i < 3; ++i) v += test_amps[i] * sin(2 * M_PI * test_freqs[i] * pos + i);
+	return v;
+}
+
+// SNR in dB of 'mode' replaying the test sample at 'ratio' times its pitch
+static double mode_snr(interpolationModeEnum mode, const std::vector<int16_t>& sample, double ratio) {
+	const int count = 16384;
+	const uint32_t start = 64u << (32 - TEST_INDEX_BITS);
+	const uint32_t incr = ratio * (1u << (32 - TEST_INDEX_BITS)) + 0.5;
+	const int32_t amp = 0xFFFF;
+	std::vector<int16_t> out(count);
+	wavetable_interpolate_mode(mode, &out[0], count, start, incr, &sample[0], TEST_LENGTH, TEST_INDEX_BITS, amp);
+	double signal = 0, noise = 0;
+	for (int i = 0; i < count; ++i) {
+		uint32_t phase = start + i * incr;
+		double want = test_signal(phase / double(1u << (32 - TEST_INDEX_BITS))) * amp / 65536.0;
+		signal += want * want;
+		noise += (out[i] - want) * (out[i] - want);
+	}
+	return 10 * log10(signal / noise);
+}
+
+// ns per sample of 'mode' over the test sample; *cycles gets TSC cycles per sample on x86
+static double time_mode(interpolationModeEnum mode, const int16_t* sample, uint32_t length, int blocks, double* cycles) {
+	const uint32_t incr = 0.749 * (1u << (32 - TEST_INDEX_BITS));
+	const uint32_t phase_limit = (TEST_LENGTH - 16) << (32 - TEST_INDEX_BITS);
+	int16_t out[AUDIO_BLOCK_SAMPLES];
+	uint32_t phase = 0;
+	auto start = std::chrono::steady_clock::now();
+#ifdef HAVE_RDTSC
+	uint64_t tsc_start = __rdtsc();
+#endif
+	for (int b = 0; b < blocks; ++b) {
+		wavetable_interpolate_mode(mode, out, AUDIO_BLOCK_SAMPLES, phase, incr, sample, length, TEST_INDEX_BITS, 0x7FFF);
+		phase += incr * AUDIO_BLOCK_SAMPLES;
+		if (phase >= phase_limit) phase -= phase_limit;
+	}
+	double samples = (double)blocks * AUDIO_BLOCK_SAMPLES;
+#ifdef HAVE_RDTSC
+	*cycles = (__rdtsc() - tsc_start) / samples;
+#else
+	*cycles = 0;
+#endif
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / samples;
+}
+
+static void bench_modes(int blocks) {
+	// the test sample with silent guard samples on both sides
+	std::vector<int16_t> padded(TEST_LENGTH + 2 * WAVETABLE_GUARD_SAMPLES);
+	const int16_t* sample = &padded[WAVETABLE_GUARD_SAMPLES];
+	for (int i = 0; i < TEST_LENGTH; ++i) padded[WAVETABLE_GUARD_SAMPLES + i] = lround(test_signal(i));
+	std::vector<int16_t> unpadded(sample, sample + TEST_LENGTH + 1);
+
+	printf("  %-8s %8s %8s %8s %9s %9s %9s\n", "mode", "ns/smp", "cyc/smp", "checked", "SNR 0.5x", "SNR .75x", "SNR 1.26x");
+	for (int m = 0; m < INTERPOLATION_COUNT; ++m) {
+		interpolationModeEnum mode = (interpolationModeEnum)m;
+		double cycles, checked_cycles;
+		double ns = time_mode(mode, sample, WAVETABLE_GUARDED, blocks, &cycles);
+		time_mode(mode, sample, TEST_LENGTH, blocks, &checked_cycles);
+		printf("  %-8s %8.2f %8.1f %8.1f %9.1f %9.1f %9.1f\n", wavetable_interpolation_name(mode), ns, cycles, checked_cycles,
+			mode_snr(mode, unpadded, 0.5), mode_snr(mode, unpadded, 0.749), mode_snr(mode, unpadded, 1.26));
+	}
+}
+
+static double harmonic_power(const std::vector<double>& wx, double window_sum, double f0) {
+	double power = 0;
+	for (int h = 1; h * f0 < AUDIO_SAMPLE_RATE_EXACT / 2; ++h) {
+		double omega = 2 * M_PI * h * f0 / AUDIO_SAMPLE_RATE_EXACT, re = 0, im = 0;
+		for (size_t i = 0; i < wx.size(); ++i) {
+			re += wx[i] * cos(omega * i);
+			im -= wx[i] * sin(omega * i);
+		}
+		double amplitude = 2 * sqrt(re * re + im * im) / window_sum;
+		power += amplitude * amplitude / 2;
+	}
+	return power;
+}
+
+// Ratio in dB of the power at the harmonics of the played pitch (below
+// Nyquist) to the rest of the power in 'x', measured with a Hann window. The
+// pitch is searched for within 0.2% of 'f0' since the phase increment is
+// only an approximation of the requested frequency.
+static double harmonic_to_alias_db(const std::vector<int16_t>& x, double f0) {
+	const size_t n = x.size();
+	double window_sum = 0, total = 0;
+	std::vector<double> wx(n);
+	for (size_t i = 0; i < n; ++i) {
+		double w = 0.5 - 0.5 * cos(2 * M_PI * i / n);
+		window_sum += w;
+		wx[i] = w * x[i];
+		total += w * x[i] * x[i];
+	}
+	total /= window_sum;
+	double lo = f0 * 0.998, hi = f0 * 1.002;
+	while (hi - lo > 1e-4) {
+		double m1 = lo + (hi - lo) / 3, m2 = hi - (hi - lo) / 3;
+		if (harmonic_power(wx, window_sum, m1) < harmonic_power(wx, window_sum, m2)) lo = m1;
+		else hi = m2;
+	}
+	double harmonic = harmonic_power(wx, window_sum, (lo + hi) / 2);
+	return 10 * log10(harmonic / fmax(total - harmonic, total * 1e-12));
+}
+
+// renders 'blocks' blocks of a held note after the attack, returns ns/block
+static double render_held_note(const instrument_data& instrument, interpolationModeEnum mode, int note, int blocks,
+	std::vector<int16_t>* out) {
+	AudioSynthWavetable voice;
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.setInstrument(instrument);
+	voice.amplitude(1.0);
+	voice.setInterpolation(mode);
+	voice.playNote(note, 127);
+	for (int b = 0; b < 8; ++b) voice.render(data);
+	auto start = std::chrono::steady_clock::now();
+	for (int b = 0; b < blocks; ++b) {
+		voice.render(data);
+		if (out) out->insert(out->end(), data, data + AUDIO_BLOCK_SAMPLES);
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / blocks;
+}
+
+// renders 'blocks' blocks of notes cycling through the instrument's range,
+// each released after 48 blocks and retriggered after 64; returns ns/block
+static double render_notes(const instrument_data& instrument, int blocks, double* cycles) {
+	AudioSynthWavetable voice;
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.setInstrument(instrument);
+	voice.amplitude(1.0);
+	auto start = std::chrono::steady_clock::now();
+#ifdef HAVE_RDTSC
+	uint64_t tsc_start = __rdtsc();
+#endif
+	for (int b = 0; b < blocks; ++b) {
+		if (b % 64 == 0) voice.playNote(36 + (b / 64) * 7 % 60, 100);
+		else if (b % 64 == 48) voice.stop();
+		voice.render(data);
+	}
+#ifdef HAVE_RDTSC
+	*cycles = (double)(__rdtsc() - tsc_start) / blocks / AUDIO_BLOCK_SAMPLES;
+#else
+	*cycles = 0;
+#endif
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / blocks;
+}
+
+static void bench_voice(const instrument_data* instrument, int blocks) {
+	wavetableKernelEnum initial = wavetable_selected_kernel();
+	for (int k = 0; k < KERNEL_COUNT; ++k) {
+		if (!wavetable_select_kernel((wavetableKernelEnum)k)) continue;
+		double cycles;
+		render_notes(*instrument, blocks / 10 + 1, &cycles);
+		double ns = render_notes(*instrument, blocks, &cycles);
+		printf("  %-8s %8.1f ns/block %6.2f cycles/sample\n", wavetable_kernel_name((wavetableKernelEnum)k), ns, cycles);
+	}
+	wavetable_select_kernel(initial);
+}
+
+// renders 'blocks' blocks of notes cycling through 'notes', released and
+// retriggered as in render_notes(); returns ns/sample
+static double render_variant_notes(const instrument_data& instrument, const std::vector<int>& notes, int blocks, double* cycles) {
+	AudioSynthWavetable voice;
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.setInstrument(instrument);
+	voice.amplitude(1.0);
+	auto start = std::chrono::steady_clock::now();
+#ifdef HAVE_RDTSC
+	uint64_t tsc_start = __rdtsc();
+#endif
+	for (int b = 0; b < blocks; ++b) {
+		if (b % 64 == 0) voice.playNote(notes[(b / 64) % notes.size()], 100);
+		else if (b % 64 == 48) voice.stop();
+		voice.render(data);
+	}
+#ifdef HAVE_RDTSC
+	*cycles = (double)(__rdtsc() - tsc_start) / blocks / AUDIO_BLOCK_SAMPLES;
+#else
+	*cycles = 0;
+#endif
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / blocks / AUDIO_BLOCK_SAMPLES;
+}
+
+static void bench_variants(const instrument_data* instrument, int blocks) {
+	AudioSynthWavetable voice;
+	voice.setInstrument(*instrument);
+	for (int variant = 0; variant < RENDER_VARIANT_COUNT; ++variant) {
+		std::vector<int> notes;
+		for (int note = 0; note < NOTE_COUNT; ++note)
+			if (AudioSynthWavetable::renderVariant(instrument->samples[voice.sampleIndex(note)]) == variant)
+				notes.push_back(note);
+		if (notes.empty()) continue;
+		double ns[2], cycles[2];
+		for (int specialized = 0; specialized < 2; ++specialized) {
+			AudioSynthWavetable::specializeRender(specialized);
+			render_variant_notes(*instrument, notes, blocks / 10 + 1, &cycles[specialized]);
+			ns[specialized] = render_variant_notes(*instrument, notes, blocks, &cycles[specialized]);
+		}
+		AudioSynthWavetable::specializeRender(true);
+		// cycles are 0 without a TSC, as in bench_voice()
+		printf("  %-8s %-8s %-10s %3d notes %6.2f generic %6.2f specialized ns/sample, %6.2f %6.2f cycles/sample (x%.2f)\n",
+			variant & RENDER_LOOP ? "loop" : "one-shot", variant & RENDER_VIBRATO ? "vibrato" : "-",
+			variant & RENDER_MODULATION ? "modulation" : "-", (int)notes.size(), ns[0], ns[1], cycles[0], cycles[1], ns[0] / ns[1]);
+	}
+}
+
+static void bench_mips(int blocks) {
+	const instrument_data* flat = find_host_instrument("Saw");
+	const instrument_data* mip = find_host_instrument("SawMip");
+	const interpolationModeEnum modes[] = { INTERPOLATION_LINEAR, INTERPOLATION_SINC };
+	for (int m = 0; m < 2; ++m) {
+		printf("  %s interpolation:\n", wavetable_interpolation_name(modes[m]));
+		printf("  %-5s %8s %10s %10s %10s %10s\n", "note", "step", "Saw dB", "SawMip dB", "Saw ns", "SawMip ns");
+		for (int note = 57; note <= 117; note += 12) {
+			std::vector<int16_t> a, b;
+			render_held_note(*flat, modes[m], note, 64, &a);
+			render_held_note(*mip, modes[m], note, 64, &b);
+			double f0 = AudioSynthWavetable::noteToFreq(note);
+			printf("  %-5d %8.2f %10.1f %10.1f %10.1f %10.1f\n", note,
+				f0 * flat->samples[0].PER_HERTZ_PHASE_INCREMENT / (0x80000000u >> (flat->samples[0].INDEX_BITS - 1)),
+				harmonic_to_alias_db(a, f0), harmonic_to_alias_db(b, f0),
+				render_held_note(*flat, modes[m], note, blocks, NULL), render_held_note(*mip, modes[m], note, blocks, NULL));
+		}
+	}
+}
+
+// renders 'blocks' blocks of a held frequency after the attack, returns ns/block
+static double render_held_frequency(const instrument_data& instrument, interpolationModeEnum mode, float freq, int blocks) {
+	AudioSynthWavetable voice;
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	voice.setInstrument(instrument);
+	voice.amplitude(1.0);
+	voice.setInterpolation(mode);
+	voice.playFrequency(freq, 127);
+	for (int b = 0; b < 8; ++b) voice.render(data);
+	auto start = std::chrono::steady_clock::now();
+	for (int b = 0; b < blocks; ++b) voice.render(data);
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / blocks;
+}
+
+static void bench_exact(int blocks) {
+	const char* names[] = { "Saw", "SawMip" };
+	const interpolationModeEnum modes[] = { INTERPOLATION_LINEAR, INTERPOLATION_SINC };
+	printf("  %-8s %-7s %-7s %12s %12s\n", "", "mode", "step", "interp ns", "copy ns");
+	for (int i = 0; i < 2; ++i) {
+		const instrument_data& instrument = *find_host_instrument(names[i]);
+		const sample_data& s = instrument.samples[0];
+		float root = (0x80000000u >> (s.INDEX_BITS - 1)) / s.PER_HERTZ_PHASE_INCREMENT;
+		for (int m = 0; m < 2; ++m) {
+			for (int step = 1; step <= 2; ++step) {
+				double ns[2];
+				for (int copy = 0; copy < 2; ++copy) {
+					AudioSynthWavetable::specializeRender(copy);
+					ns[copy] = render_held_frequency(instrument, modes[m], root * step, blocks);
+				}
+				printf("  %-8s %-7s %-7d %12.1f %12.1f (x%.2f)\n", names[i], wavetable_interpolation_name(modes[m]), step,
+					ns[0], ns[1], ns[0] / ns[1]);
+			}
+		}
+	}
+	AudioSynthWavetable::specializeRender(true);
+}
+
+// The voice allocator of Examples/MidiSynthKeyboard before WavetableVoiceManager:
+// voices[] is kept partitioned into stopped, used and free voices, and every
+// call scans one partition or another.
+template <int N>
+struct scan_allocator {
+	struct voice_t { int wavetable_id; uint8_t channel, note; };
+	voice_t voices[N];
+	int used_voices = 0, stopped_voices = 0, evict_voice = 0;
+	AudioSynthWavetablePoly<N>& wavetable;
+	const instrument_data* instrument;
+
+	scan_allocator(AudioSynthWavetablePoly<N>& wavetable, const instrument_data* instrument)
+		: wavetable(wavetable), instrument(instrument) {
+		for (int i = 0; i < N; ++i) {
+			voices[i].wavetable_id = i;
+			voices[i].channel = voices[i].note = 0xFF;
+		}
+	}
+
+	int allocateVoice(uint8_t channel, uint8_t note) {
+		int i, nonfree_voices = stopped_voices + used_voices;
+		if (nonfree_voices < N) {
+			for (i = nonfree_voices; i < N && voices[i].channel != channel; ++i);
+			if (i < N) std::swap(voices[i], voices[nonfree_voices]);
+			i = nonfree_voices;
+			used_voices++;
+		} else if (stopped_voices) {
+			i = evict_voice % stopped_voices;
+			stopped_voices--;
+			std::swap(voices[i], voices[stopped_voices]);
+			used_voices++;
+			i = stopped_voices;
+		} else {
+			i = evict_voice;
+		}
+		voices[i].channel = channel;
+		voices[i].note = note;
+		evict_voice = (evict_voice + 1) % N;
+		return voices[i].wavetable_id;
+	}
+
+	int findVoice(uint8_t channel, uint8_t note) {
+		int i, nonfree_voices = stopped_voices + used_voices;
+		for (i = stopped_voices; i < nonfree_voices && !(voices[i].channel == channel && voices[i].note == note); ++i);
+		if (i == nonfree_voices) return N;
+		std::swap(voices[i], voices[stopped_voices]);
+		--used_voices;
+		return voices[stopped_voices++].wavetable_id;
+	}
+
+	void freeVoices(void) {
+		for (int i = 0; i < stopped_voices; i++) {
+			if (wavetable[voices[i].wavetable_id].isPlaying() == false) {
+				voice_t temp = voices[i];
+				--stopped_voices;
+				voices[i] = voices[stopped_voices];
+				int nonfree_voices = stopped_voices + used_voices;
+				voices[stopped_voices] = voices[nonfree_voices];
+				voices[nonfree_voices] = temp;
+			}
+		}
+	}
+
+	void noteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+		freeVoices();
+		int v = allocateVoice(channel, note);
+		wavetable[v].setInstrument(*instrument);
+		wavetable[v].playNote(note, velocity);
+	}
+
+	void noteOff(uint8_t channel, uint8_t note) {
+		int v = findVoice(channel, note);
+		if (v != N) wavetable[v].stop();
+	}
+};
+
+template <int N>
+struct manager_allocator {
+	WavetableVoiceManager<N> manager;
+	manager_allocator(AudioSynthWavetablePoly<N>& wavetable, const instrument_data* instrument) : manager(&wavetable[0]) {
+		for (int c = 0; c < VOICE_CHANNELS; ++c) manager.setInstrument(c, instrument);
+	}
+	void noteOn(uint8_t channel, uint8_t note, uint8_t velocity) { manager.noteOn(channel, note, velocity); }
+	void noteOff(uint8_t channel, uint8_t note) { manager.noteOff(channel, note); }
+};
+
+// plays the same pseudo-random storm through an allocator, returns ns per event
+template <int N, class ALLOCATOR>
+static double note_storm(const instrument_data& instrument, int blocks) {
+	AudioSynthWavetablePoly<N> pool;
+	ALLOCATOR allocator(pool, &instrument);
+	int16_t data[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+	uint8_t held[VOICE_CHANNELS][128] = { { 0 } };
+	uint32_t seed = 12345;
+	double seconds = 0;
+	long events = 0;
+	for (int b = 0; b < blocks; ++b) {
+		auto start = std::chrono::steady_clock::now();
+		for (int e = 0; e < 16; ++e) {
+			seed = seed * 1664525 + 1013904223;
+			uint8_t channel = seed >> 28, note = 36 + (seed >> 20) % 48;
+			if (held[channel][note]) allocator.noteOff(channel, note);
+			else allocator.noteOn(channel, note, 1 + (seed >> 8) % 127);
+			held[channel][note] ^= 1;
+		}
+		seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		events += 16;
+		for (int i = 0; i < N; ++i) pool[i].render(data);
+	}
+	return seconds * 1e9 / events;
+}
+
+static void bench_voices(int blocks) {
+	const instrument_data& instrument = *find_host_instrument("SawDecline");
+	printf("  %-7s %12s %12s\n", "voices", "scan ns", "manager ns");
+	double scan = note_storm<64, scan_allocator<64> >(instrument, blocks);
+	double managed = note_storm<64, manager_allocator<64> >(instrument, blocks);
+	printf("  %-7d %12.1f %12.1f (x%.2f)\n", 64, scan, managed, scan / managed);
+	scan = note_storm<256, scan_allocator<256> >(instrument, blocks);
+	managed = note_storm<256, manager_allocator<256> >(instrument, blocks);
+	printf("  %-7d %12.1f %12.1f (x%.2f)\n", 256, scan, managed, scan / managed);
+}
+
+// Sums (and discards) what every voice transmits, like a tree of mixers.
+class bench_sink : public AudioStream
+{
+public:
+	bench_sink(void) : AudioStream(64, inputs) {}
+	virtual void update(void) {
+		for (int i = 0; i < num_inputs; ++i) {
+			audio_block_t* block = receiveReadOnly(i);
+			if (block == NULL) continue;
+			for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) sum[j] += block->data[j];
+			release(block);
+		}
+	}
+	int32_t sum[AUDIO_BLOCK_SAMPLES] = { 0 };
+private:
+	audio_block_t* inputs[64];
+};
+
+// holds a chord on the first 'notes' of 64 voices, returns ns per update_all()
+static double chord_blocks(const instrument_data& instrument, int notes, bool park, int blocks) {
+	AudioSynthWavetable::parkIdle(park);
+	std::vector<AudioSynthWavetable> voices(64);
+	bench_sink sink;
+	std::vector<AudioConnection*> cords;
+	for (int i = 0; i < 64; ++i) {
+		cords.push_back(new AudioConnection(voices[i], 0, sink, i));
+		voices[i].setInstrument(instrument);
+	}
+	for (int i = 0; i < notes; ++i) voices[i].playNote(36 + i, 100);
+	for (int b = 0; b < 16; ++b) AudioStream::update_all();
+	auto start = std::chrono::steady_clock::now();
+	for (int b = 0; b < blocks; ++b) AudioStream::update_all();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	for (size_t i = 0; i < cords.size(); ++i) delete cords[i];
+	AudioSynthWavetable::parkIdle(true);
+	return seconds * 1e9 / blocks;
+}
+
+static void bench_idle(const instrument_data& instrument, int blocks) {
+	AudioMemory(80);
+	printf("  %-7s %12s %12s %16s\n", "notes", "updated ns", "parked ns", "ns per idle voice");
+	const int chords[] = { 0, 8, 32 };
+	for (int c = 0; c < 3; ++c) {
+		double updated = chord_blocks(instrument, chords[c], false, blocks);
+		double parked = chord_blocks(instrument, chords[c], true, blocks);
+		printf("  %-7d %12.1f %12.1f %16.1f\n", chords[c], updated, parked, (updated - parked) / (64 - chords[c]));
+	}
+}
+
+static void usage(void) {
+	fprintf(stderr, "usage: wavetable_bench [-i instrument] [-n blocks] [kernels] [modes] [voice] [variants] [mips] [exact] [voices] [idle]\n");
+}
+
+static bool run_suite(int argc, char** argv, const char* name) {
+	if (optind == argc) return true;
+	for (int i = optind; i < argc; ++i)
+		if (strcmp(argv[i], name) == 0) return true;
+	return false;
+}
+
+int main(int argc, char** argv) {
+	const char* instrument_name = NULL;
+	int blocks = 200000;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "i:n:h")) != -1) {
+		switch (opt) {
+		case 'i': instrument_name = optarg; break;
+		case 'n': blocks = atoi(optarg); break;
+		default: usage(); return opt == 'h' ? 0 : 2;
+		}
+	}
+	if (blocks < 1) {
+		usage();
+		return 2;
+	}
+
+	bool ok = true;
+	for (int i = 0; run_suite(argc, argv, "kernels") && i < host_instrument_count; ++i) {
+		if (instrument_name && strcasecmp(instrument_name, host_instruments[i].name) != 0) continue;
+		printf("kernels, %s:\n", host_instruments[i].name);
+		ok = bench_kernels(host_instruments[i].instrument, blocks) && ok;
+	}
+	if (run_suite(argc, argv, "modes")) {
+		printf("interpolation modes (%s kernel for linear):\n", wavetable_kernel_name(wavetable_selected_kernel()));
+		bench_modes(blocks);
+	}
+	for (int i = 0; run_suite(argc, argv, "voice") && i < host_instrument_count; ++i) {
+		if (instrument_name && strcasecmp(instrument_name, host_instruments[i].name) != 0) continue;
+		printf("voice render, %s:\n", host_instruments[i].name);
+		bench_voice(host_instruments[i].instrument, blocks);
+	}
+	for (int i = 0; run_suite(argc, argv, "variants") && i < host_instrument_count; ++i) {
+		if (instrument_name && strcasecmp(instrument_name, host_instruments[i].name) != 0) continue;
+		printf("render variants, %s:\n", host_instruments[i].name);
+		bench_variants(host_instruments[i].instrument, blocks);
+	}
+	if (run_suite(argc, argv, "mips")) {
+		printf("mip levels, held notes (step is samples of the full-rate sample per output sample):\n");
+		bench_mips(blocks);
+	}
+	if (run_suite(argc, argv, "exact")) {
+		printf("exact-ratio playback, held notes at the root pitch and an octave up:\n");
+		bench_exact(blocks);
+	}
+	if (run_suite(argc, argv, "voices")) {
+		printf("voice allocation, note storm:\n");
+		bench_voices(blocks / 100 + 1);
+	}
+	if (run_suite(argc, argv, "idle")) {
+		printf("idle voices in the update list, 64 voices:\n");
+		bench_idle(*find_host_instrument("Viola"), blocks / 20 + 1);
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Score compiler: turns a Standard MIDI File or a Playtune score into a
+// compiled score for AudioPlayScore, with every event at its sample and
+// every note on its voice.
+//
+//   wavetable_compile [-v voices] [-n] [-c name] input output
+//
+// The input is read as a MIDI file if it starts with "MThd", and as the C
+// source of a Playtune score otherwise; -n reads a Playtune score without
+// velocities (written by miditones without -v). An output ending in .h or
+// .c is written as C source declaring an array 'name' (by default "score")
+// to compile into a sketch, and any other as a binary file that can be
+// played from memory or rendered with wavetable_render -c.
+
+#include "score_compiler.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+static void usage(void) {
+	fprintf(stderr, "usage: wavetable_compile [-v voices] [-n] [-c name] input output\n");
+}
+
+static bool read_file(const char* path, std::vector<char>& data) {
+	FILE* f = fopen(path, "rb");
+	if (f == NULL) return false;
+	char buffer[4096];
+	size_t n;
+	while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) data.insert(data.end(), buffer, buffer + n);
+	fclose(f);
+	return true;
+}
+
+int main(int argc, char** argv) {
+	int voices = 64;
+	bool velocities = true;
+	const char* name = "score";
+
+	int opt;
+	while ((opt = getopt(argc, argv, "v:nc:h")) != -1) {
+		switch (opt) {
+		case 'v': voices = atoi(optarg); break;
+		case 'n': velocities = false; break;
+		case 'c': name = optarg; break;
+		default: usage(); return opt == 'h' ? 0 : 2;
+		}
+	}
+	if (argc - optind != 2 || voices < 1 || voices > 256) {
+		usage();
+		return 2;
+	}
+	const char* input = argv[optind];
+	const char* output = argv[optind + 1];
+
+	std::vector<char> data;
+	if (!read_file(input, data)) {
+		fprintf(stderr, "cannot read '%s'\n", input);
+		return 1;
+	}
+	std::vector<score_note_event> notes;
+	bool midi = data.size() >= 4 && memcmp(data.data(), "MThd", 4) == 0;
+	if (midi) {
+		MidiMemorySource source((const uint8_t*)data.data(), data.size());
+		if (!read_midi_score(source, notes)) {
+			fprintf(stderr, "'%s' is not a type 0 or 1 MIDI file\n", input);
+			return 1;
+		}
+	} else {
+		data.push_back('\0');
+		if (!read_playtune_score(data.data(), velocities, notes)) {
+			fprintf(stderr, "'%s' is not a Playtune score\n", input);
+			return 1;
+		}
+	}
+
+	compiled_score score;
+	if (!compile_score(notes, voices, score)) {
+		fprintf(stderr, "cannot compile '%s' for %d voices\n", input, voices);
+		return 1;
+	}
+
+	size_t length = strlen(output);
+	bool source = length > 2 && (strcmp(output + length - 2, ".h") == 0 || strcmp(output + length - 2, ".c") == 0);
+	FILE* f = fopen(output, source ? "w" : "wb");
+	bool ok = f != NULL && (source ? write_score_source(f, name, score) : write_score(f, score));
+	if (f != NULL && fclose(f) != 0) ok = false;
+	if (!ok) {
+		fprintf(stderr, "cannot write '%s'\n", output);
+		return 1;
+	}
+	printf("%s score: %zu events on %d voices, %zu instrument slots, %.2f s\n", midi ? "MIDI" : "Playtune",
+		score.events.size(), score.voices_used, score.slot_programs.size(),
+		score.events.back().sample / AUDIO_SAMPLE_RATE_EXACT);
+	return 0;
+}
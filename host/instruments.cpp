@@ -0,0 +1,60 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "instruments.h"
+#include <strings.h>
+
+#include "../Examples/MidiSynth/Ocarina_samples.h"
+#include "../Examples/MidiSynth/Pizzicato_samples.h"
+#include "../Examples/MidiSynth/Viola_samples.h"
+#include "../Examples/WavetableTest2/RoomKick_samples.h"
+#include "../UnitTests/Unit_Main/Explosion_samples.h"
+#include "../UnitTests/Unit_Main/SawDecline_samples.h"
+#include "Saw_samples.h"
+#include "SawMip_samples.h"
+#include "SawPad_samples.h"
+#include "SawLayers_samples.h"
+
+const host_instrument host_instruments[] = {
+	{ "Viola", &Viola },
+	{ "Pizzicato", &Pizzicato },
+	{ "Ocarina", &Ocarina },
+	{ "SawDecline", &SawDecline },
+	{ "RoomKick", &RoomKick },
+	{ "Explosion", &Explosion },
+	{ "Saw", &Saw },
+	{ "SawMip", &SawMip },
+	{ "SawPad", &SawPad },
+	{ "SawLayers", &SawLayers },
+};
+const int host_instrument_count = sizeof(host_instruments) / sizeof(host_instrument);
+
+const instrument_data* find_host_instrument(const char* name) {
+	for (int i = 0; i < host_instrument_count; ++i)
+		if (strcasecmp(host_instruments[i].name, name) == 0)
+			return host_instruments[i].instrument;
+	return NULL;
+}
@@ -0,0 +1,127 @@
+# Audio Library for Teensy 3.X
+# Copyright (c) 2017, TeensyAudio PSU Team
+#
+# Development of this audio library was sponsored by PJRC.COM, LLC.
+# Please support PJRC's efforts to develop open source 
+# software by purchasing Teensy or other PJRC products.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice, development funding notice, and this permission
+# notice shall be included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+
+# Generates the synthetic instruments used by the host tests and benchmarks
+# by feeding a band-limited sawtooth through decoder.py's export_samples(),
+# so they are exactly what the decoder emits:
+#
+#   python3 host/make_test_instruments.py
+#
+# Saw has no mip levels, SawMip has 4. Both hold the same looped 440 Hz
+# sawtooth with every harmonic up to 20 kHz. SawPad is Saw with a delay
+# before its attack and a decay to a sustain level. SawLayers has three
+# short zones: below note 72 a soft saw (harmonics up to 2 kHz) for
+# velocities up to 63 and a bright one above, and the bright one alone from
+# note 72 up.
+import math
+import os
+import sys
+import types
+
+# export_samples() does not need sf2utils; stub it so this runs without it
+sys.modules['sf2utils'] = types.ModuleType('sf2utils')
+sys.modules['sf2utils.sf2parse'] = types.ModuleType('sf2utils.sf2parse')
+sys.modules['sf2utils.sf2parse'].Sf2File = None
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+import decoder
+
+SAMPLE_RATE = 44000
+PERIOD = 100        # samples, 440 Hz at SAMPLE_RATE
+LOOP_START = 101    # the player loops over [LOOP_START-1, LOOP_END-1)
+LOOP_END = 4001
+LENGTH = 4100
+
+
+class Sample:
+    original_pitch = 69
+    sample_rate = SAMPLE_RATE
+
+    def __init__(self, name='BrightSaw', top=20000, length=LENGTH):
+        self.name = name
+        self.duration = length
+        data = []
+        for i in range(length):
+            v = 0.0
+            for h in range(1, int(top / (SAMPLE_RATE / PERIOD)) + 1):
+                v += math.sin(2 * math.pi * h * i / PERIOD) / h
+            data.append(int(round(v * 12000)))
+        self.raw_sample_data = b''.join(x.to_bytes(2, 'little', signed=True) for x in data)
+
+
+class Bag:
+    base_note = 69
+    fine_tuning = 0
+    sample_loop = 1
+    cooked_loop_start = LOOP_START
+    cooked_loop_end = LOOP_END
+    key_range = None
+    velocity_range = None
+    volume_envelope_attack = 0.005
+    volume_envelope_hold = 0.0
+    volume_envelope_decay = 0.0
+    volume_envelope_sustain = 0.0
+    volume_envelope_release = 0.1
+    gens = {}
+
+    def __init__(self):
+        self.sample = Sample()
+
+
+class Gen:
+    def __init__(self, seconds):
+        self.cents = seconds
+
+
+class PadBag(Bag):
+    volume_envelope_attack = 0.05
+    volume_envelope_decay = 0.3
+    volume_envelope_sustain = 48000  # half of full scale
+    volume_envelope_release = 0.2
+    gens = {33: Gen(0.1)}  # delayVolEnv
+
+
+class ZoneBag(Bag):
+    cooked_loop_end = 1001
+
+    def __init__(self, name, top, key_range, velocity_range):
+        self.sample = Sample(name, top, 1100)
+        self.key_range = key_range
+        self.velocity_range = velocity_range
+
+
+def main():
+    out_dir = os.path.dirname(os.path.abspath(__file__))
+    bag = Bag()
+    decoder.export_samples([bag], None, 1, file_title='Saw', file_dir=out_dir)
+    decoder.export_samples([bag], None, 1, file_title='SawMip', file_dir=out_dir, mip_levels=4)
+    decoder.export_samples([PadBag()], None, 1, file_title='SawPad', file_dir=out_dir)
+    layers = [ZoneBag('SoftSaw', 2000, (0, 71), (0, 63)), ZoneBag('BrightSaw', 20000, (0, 71), (64, 127)),
+        ZoneBag('HighSaw', 20000, (72, 127), None)]
+    decoder.export_samples(layers, None, len(layers), file_title='SawLayers', file_dir=out_dir)
+
+
+if __name__ == '__main__':
+    main()
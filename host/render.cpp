@@ -0,0 +1,411 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Offline renderer: plays a score through a bank of AudioSynthWavetable
+// voices on the host, writes the mix to a 16-bit mono WAV file and reports
+// how many voice-blocks per second the synth sustained.
+//
+//   wavetable_render [-i instrument] [-v voices] [-s score.txt | -f song.mid | -c score.wts] [-o out.wav]
+//                    [-g gain] [-t tail_ms] [-r repeat] [-k kernel] [-m mode] [-p] [-j threads] [-b budget] [-l] [-d]
+//
+// By default every voice is its own AudioSynthWavetable object connected to
+// the output, like the example sketches; -p renders them through a single
+// AudioSynthWavetablePoly instead (up to MAX_POLY_VOICES), and -j spreads
+// the pool's voices over that many threads (0 for one per CPU), with the
+// same output. -k forces an interpolation kernel
+// (scalar, sse2, avx2, neon) instead of the fastest one the CPU supports,
+// and -m selects the interpolation mode (drop, linear, hermite, sinc).
+//
+// A score is a text file with one note per line:
+//   <start_ms> <duration_ms> <note> [velocity]
+// Blank lines and lines starting with '#' are ignored. Without -s a short
+// built-in chord progression is played. -f plays a Standard MIDI File instead,
+// every channel with the one instrument, through AudioPlayMidiFile and a pool,
+// and -c a score compiled by wavetable_compile, through AudioPlayScore.
+//
+// With -f, -b limits the voices to a load budget per block (see
+// WavetableVoiceManager::limitLoad()), with the load simulated as
+// SIMULATED_VOICE_CYCLES per sounding voice, so runs are reproducible.
+
+#include "AudioPlayMidiFile.h"
+#include "AudioPlayScore.h"
+#include "AudioSynthWavetable.h"
+#include "AudioSynthWavetablePoly.h"
+#include "instruments.h"
+#include "render_pool.h"
+#include "wavetable_kernels.h"
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+#include <strings.h>
+#include <unistd.h>
+#include <vector>
+
+#define MAX_VOICES 255
+#define MAX_POLY_VOICES 1024
+#define SIMULATED_VOICE_CYCLES 5000 // what -b charges per sounding voice per block
+
+struct note_event {
+	uint32_t start_ms;
+	uint32_t duration_ms;
+	int note;
+	int velocity;
+};
+
+// Sums all of its inputs and keeps the result; stands in for the mixer
+// cascade and I2S output of the example sketches.
+class HostOutput : public AudioStream
+{
+public:
+	HostOutput(void) : AudioStream(MAX_VOICES, inputQueueArray) {}
+	void gain(float g) { multiplier = g * 65536.0f + 0.5f; }
+	virtual void update(void);
+	std::vector<int16_t> samples;
+private:
+	int32_t multiplier = 65536;
+	audio_block_t *inputQueueArray[MAX_VOICES];
+};
+
+void HostOutput::update(void) {
+	int32_t sum[AUDIO_BLOCK_SAMPLES] = { 0 };
+	for (int i = 0; i < num_inputs; ++i) {
+		audio_block_t *block = receiveReadOnly(i);
+		if (block == NULL) continue;
+		for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) sum[j] += block->data[j];
+		release(block);
+	}
+	for (int j = 0; j < AUDIO_BLOCK_SAMPLES; ++j) {
+		int32_t v = ((int64_t)sum[j] * multiplier) >> 16;
+		samples.push_back(v > 32767 ? 32767 : v < -32768 ? -32768 : v);
+	}
+}
+
+static const note_event demo_score[] = {
+	{    0, 900, 48, 100 }, {    0, 900, 55, 90 }, {    0, 900, 60, 90 }, {    0, 900, 64, 90 },
+	{ 1000, 900, 45, 100 }, { 1000, 900, 57, 90 }, { 1000, 900, 60, 90 }, { 1000, 900, 64, 90 },
+	{ 2000, 900, 41, 100 }, { 2000, 900, 57, 90 }, { 2000, 900, 60, 90 }, { 2000, 900, 65, 90 },
+	{ 3000, 1500, 43, 100 }, { 3000, 1500, 55, 90 }, { 3000, 1500, 62, 90 }, { 3000, 1500, 67, 90 },
+	{ 3000, 1500, 71, 80 }, { 3000, 1500, 74, 80 }, { 3000, 1500, 79, 70 }, { 3000, 1500, 83, 70 },
+};
+
+static bool load_score(const char* path, std::vector<note_event>& score) {
+	FILE* f = fopen(path, "r");
+	if (f == NULL) return false;
+	char line[256];
+	while (fgets(line, sizeof(line), f)) {
+		note_event e = { 0, 0, 0, DEFAULT_AMPLITUDE };
+		char* p = line;
+		while (*p == ' ' || *p == '\t') ++p;
+		if (*p == '#' || *p == '\n' || *p == '\0') continue;
+		if (sscanf(p, "%u %u %d %d", &e.start_ms, &e.duration_ms, &e.note, &e.velocity) < 3) {
+			fprintf(stderr, "bad score line: %s", line);
+			fclose(f);
+			return false;
+		}
+		score.push_back(e);
+	}
+	fclose(f);
+	return true;
+}
+
+static void put_le(FILE* f, uint32_t v, int bytes) {
+	for (int i = 0; i < bytes; ++i) fputc((v >> (8 * i)) & 0xFF, f);
+}
+
+static bool write_wav(const char* path, const std::vector<int16_t>& samples) {
+	FILE* f = fopen(path, "wb");
+	if (f == NULL) return false;
+	uint32_t rate = AUDIO_SAMPLE_RATE_EXACT + 0.5;
+	uint32_t data_bytes = samples.size() * 2;
+	fwrite("RIFF", 1, 4, f);
+	put_le(f, 36 + data_bytes, 4);
+	fwrite("WAVEfmt ", 1, 8, f);
+	put_le(f, 16, 4);
+	put_le(f, 1, 2);            // PCM
+	put_le(f, 1, 2);            // mono
+	put_le(f, rate, 4);
+	put_le(f, rate * 2, 4);     // byte rate
+	put_le(f, 2, 2);            // block align
+	put_le(f, 16, 2);           // bits per sample
+	fwrite("data", 1, 4, f);
+	put_le(f, data_bytes, 4);
+	for (size_t i = 0; i < samples.size(); ++i) put_le(f, (uint16_t)samples[i], 2);
+	return fclose(f) == 0;
+}
+
+static uint32_t ms_to_block(uint32_t ms) {
+	return (uint64_t)ms * AUDIO_SAMPLE_RATE_EXACT / (1000.0 * AUDIO_BLOCK_SAMPLES);
+}
+
+static bool select_kernel(const char* name) {
+	for (int k = 0; k < KERNEL_COUNT; ++k) {
+		if (strcasecmp(name, wavetable_kernel_name((wavetableKernelEnum)k)) == 0)
+			return wavetable_select_kernel((wavetableKernelEnum)k);
+	}
+	return false;
+}
+
+static bool find_interpolation(const char* name, interpolationModeEnum& mode) {
+	for (int m = 0; m < INTERPOLATION_COUNT; ++m) {
+		if (strcasecmp(name, wavetable_interpolation_name((interpolationModeEnum)m)) == 0) {
+			mode = (interpolationModeEnum)m;
+			return true;
+		}
+	}
+	return false;
+}
+
+static void usage(void) {
+	fprintf(stderr,
+		"usage: wavetable_render [-i instrument] [-v voices] [-s score.txt | -f song.mid | -c score.wts] [-o out.wav]\n"
+		"                        [-g gain] [-t tail_ms] [-r repeat] [-k kernel] [-m mode] [-p] [-j threads] [-b budget] [-l] [-d]\n");
+}
+
+int main(int argc, char** argv) {
+	const char* instrument_name = "Viola";
+	const char* score_path = NULL;
+	const char* midi_path = NULL;
+	const char* compiled_path = NULL;
+	const char* wav_path = NULL;
+	int num_voices = 64;
+	int repeat = 1;
+	uint32_t tail_ms = 2000;
+	float gain = 0.25;
+	bool poly = false;
+	int threads = 1;
+	uint32_t budget = 0;
+	interpolationModeEnum interpolation = INTERPOLATION_LINEAR;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "i:v:s:f:c:o:g:t:r:k:m:pj:b:ldh")) != -1) {
+		switch (opt) {
+		case 'i': instrument_name = optarg; break;
+		case 'v': num_voices = atoi(optarg); break;
+		case 's': score_path = optarg; break;
+		case 'f': midi_path = optarg; poly = true; break;
+		case 'c': compiled_path = optarg; poly = true; break;
+		case 'o': wav_path = optarg; break;
+		case 'g': gain = atof(optarg); break;
+		case 't': tail_ms = atoi(optarg); break;
+		case 'r': repeat = atoi(optarg); break;
+		case 'k':
+			if (!select_kernel(optarg)) {
+				fprintf(stderr, "kernel '%s' is not supported on this CPU\n", optarg);
+				return 2;
+			}
+			break;
+		case 'm':
+			if (!find_interpolation(optarg, interpolation)) {
+				fprintf(stderr, "unknown interpolation mode '%s'\n", optarg);
+				return 2;
+			}
+			break;
+		case 'p': poly = true; break;
+		case 'j': threads = atoi(optarg); break;
+		case 'b': budget = strtoul(optarg, NULL, 0); break;
+		case 'l':
+			for (int i = 0; i < host_instrument_count; ++i) printf("%s\n", host_instruments[i].name);
+			return 0;
+		case 'd': Serial.begin(115200); break;
+		default: usage(); return opt == 'h' ? 0 : 2;
+		}
+	}
+	if (num_voices < 1 || num_voices > (poly ? MAX_POLY_VOICES : MAX_VOICES) || repeat < 1 || threads < 0
+			|| (budget && midi_path == NULL)) {
+		usage();
+		return 2;
+	}
+
+	const instrument_data* instrument = find_host_instrument(instrument_name);
+	if (instrument == NULL) {
+		fprintf(stderr, "unknown instrument '%s' (use -l to list)\n", instrument_name);
+		return 2;
+	}
+
+	FILE* midi_file = NULL;
+	if (midi_path && (midi_file = fopen(midi_path, "rb")) == NULL) {
+		fprintf(stderr, "cannot read MIDI file '%s'\n", midi_path);
+		return 1;
+	}
+	MidiStdioSource midi_source(midi_file);
+
+	// a compiled score is played from memory, as on the Teensy
+	std::vector<uint32_t> compiled;
+	if (compiled_path) {
+		FILE* f = fopen(compiled_path, "rb");
+		uint32_t word;
+		while (f && fread(&word, sizeof(word), 1, f) == 1) compiled.push_back(word);
+		if (f == NULL || compiled.empty()) {
+			fprintf(stderr, "cannot read compiled score '%s'\n", compiled_path);
+			return 1;
+		}
+		fclose(f);
+	}
+
+	std::vector<note_event> score;
+	if (midi_path || compiled_path) {
+		// the player dispatches its own events
+	} else if (score_path) {
+		if (!load_score(score_path, score)) {
+			fprintf(stderr, "cannot read score '%s'\n", score_path);
+			return 1;
+		}
+	} else {
+		score.assign(demo_score, demo_score + sizeof(demo_score) / sizeof(note_event));
+	}
+	std::stable_sort(score.begin(), score.end(),
+		[](const note_event& a, const note_event& b) { return a.start_ms < b.start_ms; });
+
+	// Note-offs are dispatched in time order alongside the note-ons.
+	struct dispatch { uint32_t block; bool on; size_t index; };
+	std::vector<dispatch> events;
+	uint32_t end_ms = 0;
+	for (size_t i = 0; i < score.size(); ++i) {
+		events.push_back({ ms_to_block(score[i].start_ms), true, i });
+		events.push_back({ ms_to_block(score[i].start_ms + score[i].duration_ms), false, i });
+		end_ms = std::max(end_ms, score[i].start_ms + score[i].duration_ms);
+	}
+	std::stable_sort(events.begin(), events.end(),
+		[](const dispatch& a, const dispatch& b) { return a.block < b.block; });
+	uint32_t total_blocks = ms_to_block(end_ms + tail_ms) + 1;
+	uint32_t tail_blocks = ms_to_block(tail_ms) + 1;
+
+	AudioMemory(MAX_VOICES + 8);
+	AudioSynthWavetable* bank = NULL;
+	AudioSynthWavetablePoly<MAX_POLY_VOICES>* pool = NULL;
+	WavetableRenderPool* workers = NULL;
+	AudioPlayMidiFile* midi = NULL;
+	AudioPlayScore* player = NULL;
+	std::vector<const instrument_data*> slots(256, instrument);
+	WavetableMidiSink<MAX_POLY_VOICES>* midi_sink = NULL;
+	std::vector<AudioSynthWavetable*> voices(num_voices);
+	HostOutput output;
+	std::vector<AudioConnection*> cords;
+	if (poly) {
+		// ahead of the pool in the update list, so notes start in the block they fall in
+		if (midi_path) midi = new AudioPlayMidiFile;
+		if (compiled_path) player = new AudioPlayScore;
+		pool = new AudioSynthWavetablePoly<MAX_POLY_VOICES>;
+		if (midi) {
+			midi_sink = new WavetableMidiSink<MAX_POLY_VOICES>(*pool, num_voices);
+			for (int c = 0; c < MIDI_CHANNELS; ++c) midi_sink->setInstrument(c, instrument);
+			midi_sink->voices().setLoadBudget(budget);
+		}
+		for (int i = 0; i < num_voices; ++i) voices[i] = &(*pool)[i];
+		if (threads != 1) {
+			workers = new WavetableRenderPool(threads);
+			pool->setRenderPool(workers);
+		}
+		cords.push_back(new AudioConnection(*pool, 0, output, 0));
+	} else {
+		bank = new AudioSynthWavetable[num_voices];
+		for (int i = 0; i < num_voices; ++i) {
+			voices[i] = &bank[i];
+			cords.push_back(new AudioConnection(bank[i], 0, output, i));
+		}
+	}
+	for (int i = 0; i < num_voices; ++i) {
+		voices[i]->setInstrument(*instrument);
+		voices[i]->amplitude(1.0);
+		voices[i]->setInterpolation(interpolation);
+	}
+	output.gain(gain);
+
+	uint64_t voice_blocks = 0;
+	uint64_t blocks = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repeat; ++r) {
+		std::vector<int> owner(score.size(), -1);
+		std::vector<size_t> playing(num_voices, (size_t)-1);
+		int next_voice = 0;
+		size_t e = 0;
+		output.samples.clear();
+		if (midi && !midi->play(midi_source, *midi_sink)) {
+			fprintf(stderr, "'%s' is not a type 0 or 1 MIDI file\n", midi_path);
+			return 1;
+		}
+		if (player && !player->play(compiled.data(), compiled.size() * sizeof(uint32_t), voices[0], num_voices,
+				slots.data(), slots.size())) {
+			fprintf(stderr, "'%s' is not a compiled score for %d voices\n", compiled_path, num_voices);
+			return 1;
+		}
+		bool streamed = midi || player;
+		for (uint32_t b = 0, tail = 0; streamed ? tail < tail_blocks : b < total_blocks; ++b) {
+			if (streamed && !(midi ? midi->isPlaying() : player->isPlaying())) ++tail;
+			for (; e < events.size() && events[e].block <= b; ++e) {
+				const note_event& n = score[events[e].index];
+				if (events[e].on) {
+					int v = next_voice;
+					next_voice = (next_voice + 1) % num_voices;
+					voices[v]->playNote(n.note, n.velocity);
+					owner[events[e].index] = v;
+					playing[v] = events[e].index;
+				} else {
+					int v = owner[events[e].index];
+					if (v >= 0 && playing[v] == events[e].index) voices[v]->stop();
+				}
+			}
+			for (int i = 0; i < num_voices; ++i) voice_blocks += voices[i]->isPlaying();
+			AudioStream::update_all();
+			if (budget) midi_sink->voices().limitLoad(SIMULATED_VOICE_CYCLES * pool->activeVoices());
+			++blocks;
+		}
+		for (int i = 0; i < num_voices; ++i) voices[i]->setInstrument(*instrument);
+		if (midi_sink) midi_sink->allNotesOff();
+		e = 0;
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double audio_seconds = blocks * AUDIO_BLOCK_SAMPLES / AUDIO_SAMPLE_RATE_EXACT;
+	printf("instrument %s, %d voices%s, %d threads, %zu notes, %s interpolation, %s kernel\n", instrument_name, num_voices,
+		poly ? " (poly)" : "", workers ? workers->threads() : 1, score.size(), wavetable_interpolation_name(interpolation),
+		wavetable_kernel_name(wavetable_selected_kernel()));
+	printf("rendered %llu blocks (%.2f s of audio) in %.3f s, %.1fx real time\n",
+		(unsigned long long)blocks, audio_seconds, seconds, audio_seconds / seconds);
+	printf("%llu voice-blocks, %.0f voice-blocks/s, %.1f ns/voice-block\n",
+		(unsigned long long)voice_blocks, voice_blocks / seconds,
+		voice_blocks ? seconds * 1e9 / voice_blocks : 0.0);
+	if (budget) {
+		WavetableVoiceManager<MAX_POLY_VOICES>& manager = midi_sink->voices();
+		printf("load budget %lu: %lu blocks over, %lu voices shed, %lu notes stolen, voice limit %d\n",
+			(unsigned long)budget, (unsigned long)manager.overloads(), (unsigned long)manager.shedVoices(),
+			(unsigned long)manager.steals(), manager.voiceLimit());
+	}
+
+	if (wav_path && !write_wav(wav_path, output.samples)) {
+		fprintf(stderr, "cannot write '%s'\n", wav_path);
+		return 1;
+	}
+	for (size_t i = 0; i < cords.size(); ++i) delete cords[i];
+	delete[] bank;
+	delete midi_sink;
+	delete midi;
+	delete player;
+	delete pool;
+	if (midi_file) fclose(midi_file);
+	delete workers;
+	return 0;
+}
@@ -0,0 +1,143 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "render_pool.h"
+#include <new>
+#include <stdlib.h>
+
+WavetableRenderPool::WavetableRenderPool(int threads) {
+	if (threads <= 0) threads = std::thread::hardware_concurrency();
+	worker_count = threads > 0 ? threads : 1;
+	// new[] does not honour the cache-line alignment before C++17
+	void* memory;
+	if (posix_memalign(&memory, alignof(worker_state), sizeof(worker_state) * worker_count) != 0) throw std::bad_alloc();
+	workers = static_cast<worker_state*>(memory);
+	for (int i = 0; i < worker_count; ++i) {
+		new (&workers[i]) worker_state();
+		workers[i].range.store(0, std::memory_order_relaxed);
+	}
+	// worker 0 is whichever thread calls run()
+	for (int i = 1; i < worker_count; ++i) pool.push_back(std::thread(&WavetableRenderPool::thread_main, this, i));
+}
+
+WavetableRenderPool::~WavetableRenderPool(void) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	start.notify_all();
+	for (size_t i = 0; i < pool.size(); ++i) pool[i].join();
+	for (int i = 0; i < worker_count; ++i) workers[i].~worker_state();
+	free(workers);
+}
+
+void WavetableRenderPool::run(int count, task_fn task, void* context) {
+	for (int i = 0; i < worker_count; ++i) {
+		workers[i].range.store(pack((uint64_t)count * i / worker_count, (uint64_t)count * (i + 1) / worker_count),
+			std::memory_order_relaxed);
+		workers[i].out.audible = false;
+	}
+	if (worker_count > 1) {
+		std::lock_guard<std::mutex> guard(lock);
+		this->task = task;
+		this->context = context;
+		running = worker_count - 1;
+		++generation;
+	} else {
+		this->task = task;
+		this->context = context;
+	}
+	start.notify_all();
+	work(0);
+	if (worker_count > 1) {
+		std::unique_lock<std::mutex> guard(lock);
+		finish.wait(guard, [this]() { return running == 0; });
+	}
+}
+
+// Takes the next item from the front of the worker's own share.
+bool WavetableRenderPool::take(int self, uint32_t& item) {
+	std::atomic<uint64_t>& range = workers[self].range;
+	uint64_t r = range.load(std::memory_order_acquire);
+	for (;;) {
+		uint32_t begin = r >> 32, end = (uint32_t)r;
+		if (begin >= end) return false;
+		if (range.compare_exchange_weak(r, pack(begin + 1, end), std::memory_order_acq_rel)) {
+			item = begin;
+			return true;
+		}
+	}
+}
+
+// Moves the back half of the largest other share into the worker's own,
+// which is empty; false once every share is empty.
+bool WavetableRenderPool::steal(int self) {
+	for (;;) {
+		int victim = -1;
+		uint32_t most = 0;
+		for (int i = 0; i < worker_count; ++i) {
+			uint64_t r = workers[i].range.load(std::memory_order_acquire);
+			uint32_t size = (uint32_t)r > (uint32_t)(r >> 32) ? (uint32_t)r - (uint32_t)(r >> 32) : 0;
+			if (i != self && size > most) {
+				most = size;
+				victim = i;
+			}
+		}
+		if (victim < 0) return false;
+		std::atomic<uint64_t>& range = workers[victim].range;
+		uint64_t r = range.load(std::memory_order_acquire);
+		uint32_t begin = r >> 32, end = (uint32_t)r;
+		if (begin >= end) continue;
+		uint32_t middle = end - (end - begin + 1) / 2;
+		if (range.compare_exchange_strong(r, pack(begin, middle), std::memory_order_acq_rel)) {
+			// nobody else writes an empty share, so a plain store hands it over
+			workers[self].range.store(pack(middle, end), std::memory_order_release);
+			return true;
+		}
+	}
+}
+
+void WavetableRenderPool::work(int self) {
+	uint32_t item;
+	do {
+		while (take(self, item)) task(context, item, workers[self].out);
+	} while (steal(self));
+}
+
+void WavetableRenderPool::thread_main(int self) {
+	uint32_t seen = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			start.wait(guard, [this, seen]() { return stopping || generation != seen; });
+			if (stopping) return;
+			seen = generation;
+		}
+		work(self);
+		std::lock_guard<std::mutex> guard(lock);
+		if (--running == 0) finish.notify_one();
+	}
+}
@@ -0,0 +1,107 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Worker threads for rendering many voices at once on a host. There is no
+// counterpart on the Teensy; AudioSynthWavetablePoly only uses a pool when
+// one is attached with setRenderPool().
+//
+// run() hands the items 0..count-1 to the pool's workers: each starts with
+// an even, contiguous share and takes items from its front; a worker that
+// runs dry steals the back half of the fullest share it can find. Every
+// worker owns a 32-bit accumulator block that the task sums its output
+// into, so no two threads ever write the same memory.
+
+#pragma once
+
+#include "AudioStream.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WavetableRenderPool
+{
+public:
+	// One worker's output: the sum of what its items rendered, if any did.
+	struct accumulator {
+		int32_t sum[AUDIO_BLOCK_SAMPLES];
+		bool audible;
+	} __attribute__((aligned(64)));
+
+	typedef void (*task_fn)(void* context, int item, accumulator& out);
+
+	/**
+	 * @brief Start a pool of worker threads.
+	 *
+	 * @param threads workers, counting the thread that calls run(); 0 for
+	 * one per hardware thread
+	 */
+	explicit WavetableRenderPool(int threads = 0);
+	~WavetableRenderPool(void);
+
+	int threads(void) const { return worker_count; }
+
+	/**
+	 * @brief Run task(context, item, accumulator) for every item in
+	 * 0..count-1, spread over the workers, and wait for all of them.
+	 * Clears every accumulator's 'audible' flag first; read them back with
+	 * worker() once run() returns. Allocates nothing.
+	 *
+	 * @param count the number of items
+	 * @param task called once per item, from any worker
+	 * @param context passed through to 'task'
+	 */
+	void run(int count, task_fn task, void* context);
+
+	accumulator& worker(int i) { return workers[i].out; }
+
+private:
+	// A worker's share of the items, [begin, end) packed into one word so
+	// its owner and thieves can both update it with a compare-and-swap.
+	struct worker_state {
+		std::atomic<uint64_t> range;
+		accumulator out;
+	} __attribute__((aligned(64)));
+
+	static uint64_t pack(uint32_t begin, uint32_t end) { return (uint64_t)begin << 32 | end; }
+	bool take(int self, uint32_t& item);
+	bool steal(int self);
+	void work(int self);
+	void thread_main(int self);
+
+	int worker_count;
+	worker_state* workers;
+	std::vector<std::thread> pool;
+
+	task_fn task = NULL;
+	void* context = NULL;
+	std::mutex lock;
+	std::condition_variable start, finish;
+	uint32_t generation = 0;
+	int running = 0;
+	bool stopping = false;
+};
@@ -0,0 +1,238 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "score_compiler.h"
+#include <ctype.h>
+#include <stdlib.h>
+
+// Keeps every event the MIDI file player dispatches, at its absolute sample.
+class ScoreRecorder : public MidiSink
+{
+public:
+	explicit ScoreRecorder(std::vector<score_note_event>& out) : out(out) {}
+	virtual void noteOn(uint8_t channel, uint8_t note, uint8_t velocity, int offset) {
+		out.push_back({ block + offset, SCORE_NOTE_ON, channel, note, velocity });
+	}
+	virtual void noteOff(uint8_t channel, uint8_t note, int offset) {
+		out.push_back({ block + offset, SCORE_NOTE_OFF, channel, note, 0 });
+	}
+	virtual void programChange(uint8_t channel, uint8_t program) {
+		out.push_back({ block, SCORE_PROGRAM, channel, program, 0 });
+	}
+	uint32_t block = 0;
+private:
+	std::vector<score_note_event>& out;
+};
+
+/**
+ * @brief Read a Standard MIDI File's channel events, timed exactly as
+ * AudioPlayMidiFile would play them.
+ *
+ * @return false if it is not a type 0 or type 1 MIDI file
+ */
+bool read_midi_score(MidiFileSource& source, std::vector<score_note_event>& out) {
+	ScoreRecorder recorder(out);
+	AudioPlayMidiFile player;
+	if (!player.play(source, recorder)) return false;
+	for (; player.isPlaying(); recorder.block += AUDIO_BLOCK_SAMPLES) player.playBlock();
+	return true;
+}
+
+static uint32_t ms_to_sample(uint64_t ms) {
+	return ms * AUDIO_SAMPLE_RATE_EXACT / 1000.0;
+}
+
+/**
+ * @brief Read a Playtune score, the C array of bytes written by miditones,
+ * as channel events: each tone generator becomes a channel, which plays one
+ * note at a time.
+ *
+ * @param text the source of the array; only the numbers between its braces
+ * are read
+ * @param velocities the score has a velocity after every note (miditones -v)
+ * @return false if the score is malformed
+ */
+bool read_playtune_score(const char* text, bool velocities, std::vector<score_note_event>& out) {
+	const char* p = strchr(text, '{');
+	if (p == NULL) return false;
+	std::vector<uint8_t> bytes;
+	for (++p; *p && *p != '}';) {
+		if (p[0] == '/' && p[1] == '/') {
+			while (*p && *p != '\n') ++p;
+		} else if (isdigit((unsigned char)*p)) {
+			char* end;
+			bytes.push_back(strtoul(p, &end, 0));
+			p = end;
+		} else {
+			++p;
+		}
+	}
+
+	uint64_t ms = 0;
+	uint8_t playing[16];
+	memset(playing, 0xFF, sizeof(playing));
+	for (size_t i = 0; i < bytes.size();) {
+		uint8_t c = bytes[i++], opcode = c & 0xF0, generator = c & 0x0F;
+		uint32_t sample = ms_to_sample(ms);
+		if (c < 0x80) {
+			// a delay in milliseconds, big-endian
+			if (i >= bytes.size()) return false;
+			ms += c << 8 | bytes[i++];
+		} else if (opcode == 0x90) {
+			if (i + velocities >= bytes.size()) return false;
+			uint8_t note = bytes[i++], velocity = velocities ? bytes[i++] : DEFAULT_AMPLITUDE;
+			if (playing[generator] != 0xFF) out.push_back({ sample, SCORE_NOTE_OFF, generator, playing[generator], 0 });
+			out.push_back({ sample, SCORE_NOTE_ON, generator, note, velocity });
+			playing[generator] = note;
+		} else if (opcode == 0x80) {
+			if (playing[generator] != 0xFF) out.push_back({ sample, SCORE_NOTE_OFF, generator, playing[generator], 0 });
+			playing[generator] = 0xFF;
+		} else if (opcode == 0xC0) {
+			if (i >= bytes.size()) return false;
+			out.push_back({ sample, SCORE_PROGRAM, generator, bytes[i++], 0 });
+		} else if (opcode == 0xE0 || opcode == 0xF0) {
+			// restart or stop: either way the score is over
+			break;
+		} else {
+			return false;
+		}
+	}
+	uint32_t sample = ms_to_sample(ms);
+	for (int g = 0; g < 16; ++g)
+		if (playing[g] != 0xFF) out.push_back({ sample, SCORE_NOTE_OFF, (uint8_t)g, playing[g], 0 });
+	return true;
+}
+
+/**
+ * @brief Assign voices and instrument slots to a score's notes.
+ *
+ * The allocator is simulated as the Teensy would run it: a note takes the
+ * free voice released longest ago, so release tails are cut as late as
+ * possible, or the voice that started longest ago when none is free; a note
+ * played again on the same channel retriggers its voice. An instrument
+ * event is emitted only when a voice changes slot.
+ *
+ * @param in channel events, in order of sample
+ * @param voices voices to assign, at most 256
+ * @param out the compiled events, ending with SCORE_END
+ * @return false if there are too many voices or programs
+ */
+bool compile_score(const std::vector<score_note_event>& in, int voices, compiled_score& out) {
+	struct voice {
+		int channel, note, slot;
+		bool sounding;
+		uint64_t started, released;
+	};
+	if (voices < 1 || voices > 256) return false;
+	std::vector<voice> v(voices, voice{ -1, -1, -1, false, 0, 0 });
+	uint8_t programs[16] = { 0 };
+	int slot_of[SCORE_DRUM_PROGRAM + 1];
+	for (int i = 0; i <= SCORE_DRUM_PROGRAM; ++i) slot_of[i] = -1;
+	uint64_t serial = 0;
+	uint32_t end = 0;
+	out.events.clear();
+	out.slot_programs.clear();
+	out.voices_used = 0;
+
+	for (size_t i = 0; i < in.size(); ++i) {
+		const score_note_event& e = in[i];
+		end = e.sample;
+		if (e.kind == SCORE_PROGRAM) {
+			programs[e.channel & 15] = e.note & 127;
+			continue;
+		}
+		int found = -1;
+		for (int j = 0; j < voices; ++j)
+			if (v[j].sounding && v[j].channel == e.channel && v[j].note == e.note) found = j;
+		if (e.kind == SCORE_NOTE_OFF) {
+			if (found < 0) continue;
+			out.events.push_back({ e.sample, SCORE_STOP, (uint8_t)found, 0, 0 });
+			v[found].sounding = false;
+			v[found].released = ++serial;
+			continue;
+		}
+
+		int program = e.channel == 9 ? SCORE_DRUM_PROGRAM : programs[e.channel & 15];
+		if (slot_of[program] < 0) {
+			if (out.slot_programs.size() == 256) return false;
+			slot_of[program] = out.slot_programs.size();
+			out.slot_programs.push_back(program);
+		}
+		int pick = found;
+		if (pick < 0) {
+			for (int j = 0; j < voices; ++j)
+				if (!v[j].sounding && (pick < 0 || v[j].released < v[pick].released)) pick = j;
+		}
+		if (pick < 0) {
+			pick = 0;
+			for (int j = 1; j < voices; ++j)
+				if (v[j].started < v[pick].started) pick = j;
+		}
+		if (v[pick].slot != slot_of[program]) {
+			out.events.push_back({ e.sample, SCORE_INSTRUMENT, (uint8_t)pick, (uint8_t)slot_of[program], 0 });
+			v[pick].slot = slot_of[program];
+		}
+		out.events.push_back({ e.sample, SCORE_NOTE, (uint8_t)pick, e.note, e.velocity });
+		v[pick].channel = e.channel;
+		v[pick].note = e.note;
+		v[pick].sounding = true;
+		v[pick].started = ++serial;
+		if (pick + 1 > out.voices_used) out.voices_used = pick + 1;
+	}
+	out.events.push_back({ end, SCORE_END, 0, 0, 0 });
+	return true;
+}
+
+/**
+ * @brief Write a compiled score as a file AudioPlayScore can play from
+ * memory: a wavetable_score_header and the events.
+ */
+bool write_score(FILE* f, const compiled_score& score) {
+	wavetable_score_header header = { SCORE_MAGIC, SCORE_VERSION, (uint16_t)score.voices_used,
+		(uint16_t)score.slot_programs.size(), 0, (uint32_t)score.events.size() };
+	return fwrite(&header, sizeof(header), 1, f) == 1
+		&& fwrite(score.events.data(), sizeof(wavetable_score_event), score.events.size(), f) == score.events.size();
+}
+
+/**
+ * @brief Write a compiled score as C source for a sketch: an array of
+ * events named 'name', and a comment listing the program of each slot.
+ */
+bool write_score_source(FILE* f, const char* name, const compiled_score& score) {
+	static const char* types[] = { "SCORE_NOTE", "SCORE_STOP", "SCORE_INSTRUMENT", "SCORE_END" };
+	fprintf(f, "// Compiled score for %d voices. Instrument slots:\n", score.voices_used);
+	for (size_t s = 0; s < score.slot_programs.size(); ++s) {
+		if (score.slot_programs[s] == SCORE_DRUM_PROGRAM) fprintf(f, "//   %zu: drums\n", s);
+		else fprintf(f, "//   %zu: program %d\n", s, score.slot_programs[s]);
+	}
+	fprintf(f, "#include <AudioPlayScore.h>\n\nconst wavetable_score_event %s[] = {\n", name);
+	for (size_t i = 0; i < score.events.size(); ++i) {
+		const wavetable_score_event& e = score.events[i];
+		fprintf(f, "\t{ %u, %s, %u, %u, %u },\n", e.sample, types[e.type], e.voice, e.data1, e.data2);
+	}
+	fprintf(f, "};\n");
+	return ferror(f) == 0;
+}
@@ -0,0 +1,64 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Compiles Standard MIDI Files and Playtune scores into the event streams
+// AudioPlayScore plays. Everything a player would otherwise work out per
+// event is done here once: delta times and tempo become absolute sample
+// numbers, and a simulated voice allocator picks the voice and instrument
+// slot of every note, so the Teensy only compares a counter and dispatches.
+
+#pragma once
+
+#include "AudioPlayMidiFile.h"
+#include "AudioPlayScore.h"
+#include <stdio.h>
+#include <vector>
+
+enum scoreNoteKindEnum { SCORE_NOTE_ON, SCORE_NOTE_OFF, SCORE_PROGRAM };
+
+// A channel event at an absolute sample, before voices are assigned.
+struct score_note_event {
+	uint32_t sample;
+	uint8_t kind;      // scoreNoteKindEnum
+	uint8_t channel;
+	uint8_t note;      // SCORE_PROGRAM: the program
+	uint8_t velocity;
+};
+
+#define SCORE_DRUM_PROGRAM 128 // the slot key of MIDI channel 10, whatever its program
+
+// A compiled score and what its instrument slots stand for.
+struct compiled_score {
+	std::vector<wavetable_score_event> events;
+	std::vector<int> slot_programs; // program of each slot, or SCORE_DRUM_PROGRAM
+	int voices_used;
+};
+
+bool read_midi_score(MidiFileSource& source, std::vector<score_note_event>& out);
+bool read_playtune_score(const char* text, bool velocities, std::vector<score_note_event>& out);
+bool compile_score(const std::vector<score_note_event>& in, int voices, compiled_score& out);
+bool write_score(FILE* f, const compiled_score& score);
+bool write_score_source(FILE* f, const char* name, const compiled_score& score);
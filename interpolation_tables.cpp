@@ -0,0 +1,780 @@
+// Generated by interpolation_tables.py -- do not edit.
+#include "wavetable_kernels.h"
+
+#if INTERPOLATION_COEFFICIENT_BITS != 14 || HERMITE_TABLE_BITS != 8 || SINC_TABLE_BITS != 9 || SINC_TAPS != 8
+#error "interpolation_tables.cpp is out of date, rerun interpolation_tables.py"
+#endif
+
+const int16_t hermite_table[256][4] = {
+	{     0,  16384,      0,      0},
+	{   -32,  16384,     32,      0},
+	{   -63,  16381,     66,      0},
+	{   -94,  16379,    100,     -1},
+	{  -124,  16374,    136,     -2},
+	{  -154,  16369,    172,     -3},
+	{  -183,  16361,    210,     -4},
+	{  -212,  16354,    248,     -6},
+	{  -240,  16345,    287,     -8},
+	{  -268,  16335,    327,    -10},
+	{  -295,  16322,    369,    -12},
+	{  -322,  16309,    411,    -14},
+	{  -349,  16297,    453,    -17},
+	{  -375,  16282,    497,    -20},
+	{  -400,  16265,    542,    -23},
+	{  -425,  16247,    588,    -26},
+	{  -450,  16230,    634,    -30},
+	{  -474,  16211,    681,    -34},
+	{  -498,  16191,    729,    -38},
+	{  -521,  16169,    778,    -42},
+	{  -544,  16146,    828,    -46},
+	{  -566,  16122,    879,    -51},
+	{  -588,  16097,    930,    -55},
+	{  -610,  16071,    983,    -60},
+	{  -631,  16044,   1036,    -65},
+	{  -651,  16015,   1090,    -70},
+	{  -672,  15988,   1144,    -76},
+	{  -691,  15957,   1200,    -82},
+	{  -711,  15926,   1256,    -87},
+	{  -730,  15894,   1313,    -93},
+	{  -748,  15861,   1370,    -99},
+	{  -766,  15827,   1429,   -106},
+	{  -784,  15792,   1488,   -112},
+	{  -801,  15756,   1548,   -119},
+	{  -818,  15719,   1608,   -125},
+	{  -835,  15681,   1670,   -132},
+	{  -851,  15642,   1732,   -139},
+	{  -866,  15602,   1794,   -146},
+	{  -882,  15562,   1858,   -154},
+	{  -897,  15520,   1922,   -161},
+	{  -911,  15478,   1986,   -169},
+	{  -925,  15433,   2052,   -176},
+	{  -939,  15390,   2117,   -184},
+	{  -953,  15345,   2184,   -192},
+	{  -966,  15299,   2251,   -200},
+	{  -978,  15252,   2319,   -209},
+	{  -991,  15205,   2387,   -217},
+	{ -1002,  15155,   2456,   -225},
+	{ -1014,  15106,   2526,   -234},
+	{ -1025,  15056,   2596,   -243},
+	{ -1036,  15004,   2667,   -251},
+	{ -1047,  14953,   2738,   -260},
+	{ -1057,  14900,   2810,   -269},
+	{ -1066,  14846,   2882,   -278},
+	{ -1076,  14793,   2955,   -288},
+	{ -1085,  14737,   3029,   -297},
+	{ -1094,  14681,   3103,   -306},
+	{ -1102,  14625,   3177,   -316},
+	{ -1110,  14567,   3252,   -325},
+	{ -1118,  14509,   3328,   -335},
+	{ -1125,  14450,   3404,   -345},
+	{ -1133,  14391,   3480,   -354},
+	{ -1139,  14330,   3557,   -364},
+	{ -1146,  14270,   3634,   -374},
+	{ -1152,  14208,   3712,   -384},
+	{ -1158,  14146,   3790,   -394},
+	{ -1163,  14082,   3869,   -404},
+	{ -1169,  14019,   3948,   -414},
+	{ -1174,  13955,   4027,   -424},
+	{ -1178,  13890,   4107,   -435},
+	{ -1182,  13823,   4188,   -445},
+	{ -1187,  13758,   4268,   -455},
+	{ -1190,  13691,   4349,   -466},
+	{ -1194,  13623,   4431,   -476},
+	{ -1197,  13556,   4512,   -487},
+	{ -1200,  13486,   4595,   -497},
+	{ -1202,  13417,   4677,   -508},
+	{ -1205,  13347,   4760,   -518},
+	{ -1207,  13277,   4843,   -529},
+	{ -1208,  13205,   4926,   -539},
+	{ -1210,  13134,   5010,   -550},
+	{ -1211,  13062,   5094,   -561},
+	{ -1212,  12989,   5178,   -571},
+	{ -1213,  12916,   5263,   -582},
+	{ -1213,  12842,   5348,   -593},
+	{ -1214,  12768,   5433,   -603},
+	{ -1214,  12694,   5518,   -614},
+	{ -1213,  12618,   5604,   -625},
+	{ -1213,  12542,   5690,   -635},
+	{ -1212,  12466,   5776,   -646},
+	{ -1211,  12390,   5862,   -657},
+	{ -1210,  12312,   5949,   -667},
+	{ -1208,  12235,   6035,   -678},
+	{ -1207,  12157,   6122,   -688},
+	{ -1205,  12079,   6209,   -699},
+	{ -1202,  11998,   6297,   -709},
+	{ -1200,  11920,   6384,   -720},
+	{ -1197,  11839,   6472,   -730},
+	{ -1195,  11761,   6559,   -741},
+	{ -1192,  11680,   6647,   -751},
+	{ -1188,  11599,   6735,   -762},
+	{ -1185,  11518,   6823,   -772},
+	{ -1181,  11436,   6911,   -782},
+	{ -1177,  11354,   7000,   -793},
+	{ -1173,  11272,   7088,   -803},
+	{ -1169,  11189,   7177,   -813},
+	{ -1165,  11107,   7265,   -823},
+	{ -1160,  11023,   7354,   -833},
+	{ -1155,  10939,   7443,   -843},
+	{ -1150,  10856,   7531,   -853},
+	{ -1145,  10772,   7620,   -863},
+	{ -1140,  10687,   7709,   -872},
+	{ -1134,  10602,   7798,   -882},
+	{ -1128,  10517,   7887,   -892},
+	{ -1122,  10431,   7976,   -901},
+	{ -1116,  10346,   8065,   -911},
+	{ -1110,  10260,   8154,   -920},
+	{ -1104,  10175,   8242,   -929},
+	{ -1097,  10088,   8331,   -938},
+	{ -1091,  10002,   8420,   -947},
+	{ -1084,   9915,   8509,   -956},
+	{ -1077,   9829,   8597,   -965},
+	{ -1070,   9742,   8686,   -974},
+	{ -1062,   9653,   8775,   -982},
+	{ -1055,   9567,   8863,   -991},
+	{ -1047,   9479,   8951,   -999},
+	{ -1040,   9392,   9040,  -1008},
+	{ -1032,   9304,   9128,  -1016},
+	{ -1024,   9216,   9216,  -1024},
+	{ -1016,   9128,   9304,  -1032},
+	{ -1008,   9040,   9392,  -1040},
+	{  -999,   8951,   9479,  -1047},
+	{  -991,   8863,   9567,  -1055},
+	{  -982,   8775,   9653,  -1062},
+	{  -974,   8686,   9742,  -1070},
+	{  -965,   8597,   9829,  -1077},
+	{  -956,   8509,   9915,  -1084},
+	{  -947,   8420,  10002,  -1091},
+	{  -938,   8331,  10088,  -1097},
+	{  -929,   8242,  10175,  -1104},
+	{  -920,   8154,  10260,  -1110},
+	{  -911,   8065,  10346,  -1116},
+	{  -901,   7976,  10431,  -1122},
+	{  -892,   7887,  10517,  -1128},
+	{  -882,   7798,  10602,  -1134},
+	{  -872,   7709,  10687,  -1140},
+	{  -863,   7620,  10772,  -1145},
+	{  -853,   7531,  10856,  -1150},
+	{  -843,   7443,  10939,  -1155},
+	{  -833,   7354,  11023,  -1160},
+	{  -823,   7265,  11107,  -1165},
+	{  -813,   7177,  11189,  -1169},
+	{  -803,   7088,  11272,  -1173},
+	{  -793,   7000,  11354,  -1177},
+	{  -782,   6911,  11436,  -1181},
+	{  -772,   6823,  11518,  -1185},
+	{  -762,   6735,  11599,  -1188},
+	{  -751,   6647,  11680,  -1192},
+	{  -741,   6559,  11761,  -1195},
+	{  -730,   6472,  11839,  -1197},
+	{  -720,   6384,  11920,  -1200},
+	{  -709,   6297,  11998,  -1202},
+	{  -699,   6209,  12079,  -1205},
+	{  -688,   6122,  12157,  -1207},
+	{  -678,   6035,  12235,  -1208},
+	{  -667,   5949,  12312,  -1210},
+	{  -657,   5862,  12390,  -1211},
+	{  -646,   5776,  12466,  -1212},
+	{  -635,   5690,  12542,  -1213},
+	{  -625,   5604,  12618,  -1213},
+	{  -614,   5518,  12694,  -1214},
+	{  -603,   5433,  12768,  -1214},
+	{  -593,   5348,  12842,  -1213},
+	{  -582,   5263,  12916,  -1213},
+	{  -571,   5178,  12989,  -1212},
+	{  -561,   5094,  13062,  -1211},
+	{  -550,   5010,  13134,  -1210},
+	{  -539,   4926,  13205,  -1208},
+	{  -529,   4843,  13277,  -1207},
+	{  -518,   4760,  13347,  -1205},
+	{  -508,   4677,  13417,  -1202},
+	{  -497,   4595,  13486,  -1200},
+	{  -487,   4512,  13556,  -1197},
+	{  -476,   4431,  13623,  -1194},
+	{  -466,   4349,  13691,  -1190},
+	{  -455,   4268,  13758,  -1187},
+	{  -445,   4188,  13823,  -1182},
+	{  -435,   4107,  13890,  -1178},
+	{  -424,   4027,  13955,  -1174},
+	{  -414,   3948,  14019,  -1169},
+	{  -404,   3869,  14082,  -1163},
+	{  -394,   3790,  14146,  -1158},
+	{  -384,   3712,  14208,  -1152},
+	{  -374,   3634,  14270,  -1146},
+	{  -364,   3557,  14330,  -1139},
+	{  -354,   3480,  14391,  -1133},
+	{  -345,   3404,  14450,  -1125},
+	{  -335,   3328,  14509,  -1118},
+	{  -325,   3252,  14567,  -1110},
+	{  -316,   3177,  14625,  -1102},
+	{  -306,   3103,  14681,  -1094},
+	{  -297,   3029,  14737,  -1085},
+	{  -288,   2955,  14793,  -1076},
+	{  -278,   2882,  14846,  -1066},
+	{  -269,   2810,  14900,  -1057},
+	{  -260,   2738,  14953,  -1047},
+	{  -251,   2667,  15004,  -1036},
+	{  -243,   2596,  15056,  -1025},
+	{  -234,   2526,  15106,  -1014},
+	{  -225,   2456,  15155,  -1002},
+	{  -217,   2387,  15205,   -991},
+	{  -209,   2319,  15252,   -978},
+	{  -200,   2251,  15299,   -966},
+	{  -192,   2184,  15345,   -953},
+	{  -184,   2117,  15390,   -939},
+	{  -176,   2052,  15433,   -925},
+	{  -169,   1986,  15478,   -911},
+	{  -161,   1922,  15520,   -897},
+	{  -154,   1858,  15562,   -882},
+	{  -146,   1794,  15602,   -866},
+	{  -139,   1732,  15642,   -851},
+	{  -132,   1670,  15681,   -835},
+	{  -125,   1608,  15719,   -818},
+	{  -119,   1548,  15756,   -801},
+	{  -112,   1488,  15792,   -784},
+	{  -106,   1429,  15827,   -766},
+	{   -99,   1370,  15861,   -748},
+	{   -93,   1313,  15894,   -730},
+	{   -87,   1256,  15926,   -711},
+	{   -82,   1200,  15957,   -691},
+	{   -76,   1144,  15988,   -672},
+	{   -70,   1090,  16015,   -651},
+	{   -65,   1036,  16044,   -631},
+	{   -60,    983,  16071,   -610},
+	{   -55,    930,  16097,   -588},
+	{   -51,    879,  16122,   -566},
+	{   -46,    828,  16146,   -544},
+	{   -42,    778,  16169,   -521},
+	{   -38,    729,  16191,   -498},
+	{   -34,    681,  16211,   -474},
+	{   -30,    634,  16230,   -450},
+	{   -26,    588,  16247,   -425},
+	{   -23,    542,  16265,   -400},
+	{   -20,    497,  16282,   -375},
+	{   -17,    453,  16297,   -349},
+	{   -14,    411,  16309,   -322},
+	{   -12,    369,  16322,   -295},
+	{   -10,    327,  16335,   -268},
+	{    -8,    287,  16345,   -240},
+	{    -6,    248,  16354,   -212},
+	{    -4,    210,  16361,   -183},
+	{    -3,    172,  16369,   -154},
+	{    -2,    136,  16374,   -124},
+	{    -1,    100,  16379,    -94},
+	{     0,     66,  16381,    -63},
+	{     0,     32,  16384,    -32},
+};
+
+const int16_t sinc_table[512][8] = {
+	{     0,      0,      0,  16384,      0,      0,      0,      0},
+	{    -2,      8,    -27,  16384,     27,     -8,      2,      0},
+	{    -3,     15,    -54,  16384,     54,    -16,      4,      0},
+	{    -5,     23,    -80,  16383,     81,    -23,      5,      0},
+	{    -7,     31,   -106,  16381,    109,    -31,      7,      0},
+	{    -9,     38,   -133,  16383,    136,    -39,      9,     -1},
+	{   -10,     46,   -159,  16380,    164,    -47,     11,     -1},
+	{   -12,     53,   -185,  16379,    192,    -55,     13,     -1},
+	{   -14,     61,   -211,  16378,    220,    -63,     14,     -1},
+	{   -15,     68,   -236,  16375,    248,    -71,     16,     -1},
+	{   -17,     75,   -262,  16374,    276,    -79,     18,     -1},
+	{   -18,     83,   -287,  16370,    304,    -87,     20,     -1},
+	{   -20,     90,   -313,  16369,    333,    -95,     22,     -2},
+	{   -22,     97,   -338,  16367,    362,   -104,     24,     -2},
+	{   -23,    104,   -363,  16364,    390,   -112,     26,     -2},
+	{   -25,    111,   -387,  16360,    419,   -120,     28,     -2},
+	{   -26,    119,   -412,  16356,    448,   -128,     29,     -2},
+	{   -28,    126,   -437,  16353,    478,   -137,     31,     -2},
+	{   -29,    133,   -461,  16349,    507,   -145,     33,     -3},
+	{   -31,    140,   -485,  16345,    537,   -154,     35,     -3},
+	{   -32,    147,   -509,  16340,    566,   -162,     37,     -3},
+	{   -34,    154,   -533,  16336,    596,   -171,     39,     -3},
+	{   -35,    160,   -557,  16331,    626,   -179,     41,     -3},
+	{   -37,    167,   -581,  16327,    656,   -188,     43,     -3},
+	{   -38,    174,   -604,  16321,    686,   -196,     45,     -4},
+	{   -40,    181,   -628,  16317,    716,   -205,     47,     -4},
+	{   -41,    187,   -651,  16310,    747,   -213,     49,     -4},
+	{   -43,    194,   -674,  16304,    777,   -222,     52,     -4},
+	{   -44,    201,   -697,  16297,    808,   -231,     54,     -4},
+	{   -45,    207,   -720,  16291,    839,   -240,     56,     -4},
+	{   -47,    214,   -742,  16284,    870,   -248,     58,     -5},
+	{   -48,    220,   -765,  16278,    901,   -257,     60,     -5},
+	{   -50,    227,   -787,  16271,    932,   -266,     62,     -5},
+	{   -51,    233,   -809,  16263,    964,   -275,     64,     -5},
+	{   -52,    240,   -831,  16255,    995,   -284,     66,     -5},
+	{   -53,    246,   -853,  16248,   1027,   -293,     68,     -6},
+	{   -55,    252,   -875,  16241,   1058,   -302,     71,     -6},
+	{   -56,    258,   -896,  16232,   1090,   -311,     73,     -6},
+	{   -57,    265,   -918,  16223,   1122,   -320,     75,     -6},
+	{   -59,    271,   -939,  16215,   1154,   -329,     77,     -6},
+	{   -60,    277,   -960,  16206,   1187,   -338,     79,     -7},
+	{   -61,    283,   -981,  16196,   1219,   -347,     82,     -7},
+	{   -62,    289,  -1002,  16186,   1252,   -356,     84,     -7},
+	{   -64,    295,  -1023,  16178,   1284,   -365,     86,     -7},
+	{   -65,    301,  -1043,  16169,   1317,   -375,     88,     -8},
+	{   -66,    307,  -1064,  16158,   1350,   -384,     91,     -8},
+	{   -67,    312,  -1084,  16148,   1383,   -393,     93,     -8},
+	{   -68,    318,  -1104,  16137,   1416,   -402,     95,     -8},
+	{   -69,    324,  -1124,  16127,   1449,   -412,     97,     -8},
+	{   -71,    330,  -1144,  16116,   1483,   -421,    100,     -9},
+	{   -72,    335,  -1164,  16106,   1516,   -430,    102,     -9},
+	{   -73,    341,  -1183,  16094,   1550,   -440,    104,     -9},
+	{   -74,    347,  -1203,  16081,   1584,   -449,    107,     -9},
+	{   -75,    352,  -1222,  16071,   1618,   -459,    109,    -10},
+	{   -76,    358,  -1241,  16058,   1652,   -468,    111,    -10},
+	{   -77,    363,  -1260,  16046,   1686,   -478,    114,    -10},
+	{   -78,    368,  -1278,  16033,   1720,   -487,    116,    -10},
+	{   -79,    374,  -1297,  16022,   1754,   -497,    118,    -11},
+	{   -80,    379,  -1316,  16008,   1789,   -506,    121,    -11},
+	{   -81,    384,  -1334,  15995,   1824,   -516,    123,    -11},
+	{   -82,    390,  -1352,  15981,   1858,   -526,    126,    -11},
+	{   -83,    395,  -1370,  15968,   1893,   -535,    128,    -12},
+	{   -84,    400,  -1388,  15954,   1928,   -545,    131,    -12},
+	{   -85,    405,  -1406,  15941,   1963,   -555,    133,    -12},
+	{   -86,    410,  -1423,  15927,   1998,   -564,    135,    -13},
+	{   -87,    415,  -1441,  15912,   2034,   -574,    138,    -13},
+	{   -88,    420,  -1458,  15898,   2069,   -584,    140,    -13},
+	{   -89,    425,  -1475,  15882,   2105,   -594,    143,    -13},
+	{   -90,    430,  -1492,  15869,   2140,   -604,    145,    -14},
+	{   -91,    435,  -1509,  15852,   2176,   -613,    148,    -14},
+	{   -92,    439,  -1526,  15838,   2212,   -623,    150,    -14},
+	{   -93,    444,  -1542,  15822,   2248,   -633,    153,    -15},
+	{   -94,    449,  -1559,  15807,   2284,   -643,    155,    -15},
+	{   -94,    453,  -1575,  15790,   2320,   -653,    158,    -15},
+	{   -95,    458,  -1591,  15773,   2357,   -663,    160,    -15},
+	{   -96,    463,  -1607,  15757,   2393,   -673,    163,    -16},
+	{   -97,    467,  -1623,  15740,   2430,   -683,    166,    -16},
+	{   -98,    472,  -1638,  15723,   2466,   -693,    168,    -16},
+	{   -98,    476,  -1654,  15706,   2503,   -703,    171,    -17},
+	{   -99,    480,  -1669,  15689,   2540,   -713,    173,    -17},
+	{  -100,    485,  -1684,  15670,   2577,   -723,    176,    -17},
+	{  -101,    489,  -1699,  15654,   2614,   -733,    178,    -18},
+	{  -102,    493,  -1714,  15636,   2651,   -743,    181,    -18},
+	{  -102,    497,  -1729,  15617,   2688,   -753,    184,    -18},
+	{  -103,    502,  -1744,  15599,   2726,   -763,    186,    -19},
+	{  -104,    506,  -1758,  15580,   2763,   -773,    189,    -19},
+	{  -104,    510,  -1772,  15560,   2801,   -784,    192,    -19},
+	{  -105,    514,  -1787,  15543,   2839,   -794,    194,    -20},
+	{  -106,    518,  -1801,  15524,   2876,   -804,    197,    -20},
+	{  -106,    522,  -1815,  15504,   2914,   -814,    199,    -20},
+	{  -107,    526,  -1828,  15484,   2952,   -824,    202,    -21},
+	{  -108,    529,  -1842,  15465,   2990,   -834,    205,    -21},
+	{  -108,    533,  -1855,  15443,   3029,   -845,    208,    -21},
+	{  -109,    537,  -1869,  15425,   3067,   -855,    210,    -22},
+	{  -110,    541,  -1882,  15404,   3105,   -865,    213,    -22},
+	{  -110,    544,  -1895,  15382,   3144,   -875,    216,    -22},
+	{  -111,    548,  -1908,  15364,   3182,   -886,    218,    -23},
+	{  -111,    552,  -1920,  15340,   3221,   -896,    221,    -23},
+	{  -112,    555,  -1933,  15319,   3260,   -906,    224,    -23},
+	{  -113,    559,  -1945,  15299,   3299,   -917,    226,    -24},
+	{  -113,    562,  -1958,  15277,   3338,   -927,    229,    -24},
+	{  -114,    565,  -1970,  15256,   3377,   -937,    232,    -25},
+	{  -114,    569,  -1982,  15232,   3416,   -947,    235,    -25},
+	{  -115,    572,  -1994,  15212,   3455,   -958,    237,    -25},
+	{  -115,    575,  -2005,  15189,   3494,   -968,    240,    -26},
+	{  -116,    579,  -2017,  15166,   3534,   -979,    243,    -26},
+	{  -116,    582,  -2029,  15143,   3573,   -989,    246,    -26},
+	{  -117,    585,  -2040,  15121,   3613,   -999,    248,    -27},
+	{  -117,    588,  -2051,  15098,   3652,  -1010,    251,    -27},
+	{  -118,    591,  -2062,  15075,   3692,  -1020,    254,    -28},
+	{  -118,    594,  -2073,  15050,   3732,  -1030,    257,    -28},
+	{  -118,    597,  -2084,  15026,   3772,  -1041,    260,    -28},
+	{  -119,    600,  -2094,  15003,   3812,  -1051,    262,    -29},
+	{  -119,    603,  -2105,  14979,   3852,  -1062,    265,    -29},
+	{  -120,    606,  -2115,  14955,   3892,  -1072,    268,    -30},
+	{  -120,    609,  -2125,  14929,   3932,  -1082,    271,    -30},
+	{  -120,    611,  -2135,  14904,   3973,  -1093,    274,    -30},
+	{  -121,    614,  -2145,  14881,   4013,  -1103,    276,    -31},
+	{  -121,    617,  -2155,  14855,   4054,  -1114,    279,    -31},
+	{  -122,    619,  -2164,  14831,   4094,  -1124,    282,    -32},
+	{  -122,    622,  -2174,  14804,   4135,  -1134,    285,    -32},
+	{  -122,    625,  -2183,  14777,   4176,  -1145,    288,    -32},
+	{  -123,    627,  -2192,  14754,   4216,  -1155,    290,    -33},
+	{  -123,    630,  -2201,  14727,   4257,  -1166,    293,    -33},
+	{  -123,    632,  -2210,  14701,   4298,  -1176,    296,    -34},
+	{  -123,    634,  -2219,  14674,   4339,  -1186,    299,    -34},
+	{  -124,    637,  -2228,  14649,   4380,  -1197,    302,    -35},
+	{  -124,    639,  -2236,  14621,   4421,  -1207,    305,    -35},
+	{  -124,    641,  -2244,  14593,   4463,  -1218,    308,    -35},
+	{  -125,    643,  -2253,  14569,   4504,  -1228,    310,    -36},
+	{  -125,    646,  -2261,  14540,   4545,  -1238,    313,    -36},
+	{  -125,    648,  -2269,  14513,   4587,  -1249,    316,    -37},
+	{  -125,    650,  -2277,  14485,   4628,  -1259,    319,    -37},
+	{  -125,    652,  -2284,  14456,   4670,  -1269,    322,    -38},
+	{  -126,    654,  -2292,  14430,   4711,  -1280,    325,    -38},
+	{  -126,    656,  -2299,  14401,   4753,  -1290,    328,    -39},
+	{  -126,    658,  -2306,  14372,   4795,  -1300,    330,    -39},
+	{  -126,    660,  -2314,  14344,   4837,  -1311,    333,    -39},
+	{  -126,    661,  -2321,  14316,   4879,  -1321,    336,    -40},
+	{  -127,    663,  -2328,  14288,   4920,  -1331,    339,    -40},
+	{  -127,    665,  -2334,  14259,   4962,  -1342,    342,    -41},
+	{  -127,    667,  -2341,  14228,   5005,  -1352,    345,    -41},
+	{  -127,    668,  -2347,  14199,   5047,  -1362,    348,    -42},
+	{  -127,    670,  -2354,  14170,   5089,  -1373,    351,    -42},
+	{  -127,    672,  -2360,  14141,   5131,  -1383,    353,    -43},
+	{  -127,    673,  -2366,  14111,   5173,  -1393,    356,    -43},
+	{  -128,    675,  -2372,  14081,   5216,  -1403,    359,    -44},
+	{  -128,    676,  -2378,  14052,   5258,  -1414,    362,    -44},
+	{  -128,    678,  -2384,  14021,   5301,  -1424,    365,    -45},
+	{  -128,    679,  -2389,  13990,   5343,  -1434,    368,    -45},
+	{  -128,    681,  -2395,  13959,   5386,  -1444,    371,    -46},
+	{  -128,    682,  -2400,  13929,   5428,  -1455,    374,    -46},
+	{  -128,    683,  -2405,  13899,   5471,  -1465,    376,    -47},
+	{  -128,    684,  -2410,  13867,   5514,  -1475,    379,    -47},
+	{  -128,    686,  -2415,  13835,   5556,  -1485,    382,    -47},
+	{  -128,    687,  -2420,  13804,   5599,  -1495,    385,    -48},
+	{  -128,    688,  -2425,  13772,   5642,  -1505,    388,    -48},
+	{  -128,    689,  -2429,  13740,   5685,  -1515,    391,    -49},
+	{  -128,    690,  -2434,  13708,   5728,  -1525,    394,    -49},
+	{  -128,    691,  -2438,  13677,   5771,  -1535,    396,    -50},
+	{  -128,    692,  -2442,  13644,   5814,  -1545,    399,    -50},
+	{  -128,    693,  -2446,  13612,   5857,  -1555,    402,    -51},
+	{  -128,    694,  -2450,  13579,   5900,  -1565,    405,    -51},
+	{  -128,    695,  -2454,  13547,   5943,  -1575,    408,    -52},
+	{  -128,    696,  -2457,  13513,   5986,  -1585,    411,    -52},
+	{  -128,    697,  -2461,  13481,   6029,  -1595,    414,    -53},
+	{  -128,    697,  -2464,  13448,   6073,  -1605,    416,    -53},
+	{  -128,    698,  -2468,  13416,   6116,  -1615,    419,    -54},
+	{  -128,    699,  -2471,  13382,   6159,  -1625,    422,    -54},
+	{  -128,    699,  -2474,  13349,   6203,  -1635,    425,    -55},
+	{  -128,    700,  -2477,  13315,   6246,  -1645,    428,    -55},
+	{  -128,    701,  -2480,  13281,   6289,  -1654,    431,    -56},
+	{  -127,    701,  -2483,  13247,   6333,  -1664,    433,    -56},
+	{  -127,    702,  -2485,  13213,   6376,  -1674,    436,    -57},
+	{  -127,    702,  -2488,  13179,   6420,  -1684,    439,    -57},
+	{  -127,    703,  -2490,  13144,   6463,  -1693,    442,    -58},
+	{  -127,    703,  -2492,  13110,   6507,  -1703,    445,    -59},
+	{  -127,    703,  -2494,  13076,   6551,  -1713,    447,    -59},
+	{  -127,    704,  -2496,  13041,   6594,  -1722,    450,    -60},
+	{  -127,    704,  -2498,  13006,   6638,  -1732,    453,    -60},
+	{  -126,    704,  -2500,  12971,   6681,  -1741,    456,    -61},
+	{  -126,    705,  -2502,  12935,   6725,  -1751,    459,    -61},
+	{  -126,    705,  -2503,  12900,   6769,  -1760,    461,    -62},
+	{  -126,    705,  -2505,  12865,   6813,  -1770,    464,    -62},
+	{  -126,    705,  -2506,  12830,   6856,  -1779,    467,    -63},
+	{  -126,    705,  -2507,  12793,   6900,  -1788,    470,    -63},
+	{  -125,    705,  -2508,  12758,   6944,  -1798,    472,    -64},
+	{  -125,    705,  -2509,  12721,   6988,  -1807,    475,    -64},
+	{  -125,    705,  -2510,  12686,   7031,  -1816,    478,    -65},
+	{  -125,    705,  -2511,  12650,   7075,  -1826,    481,    -65},
+	{  -125,    705,  -2511,  12614,   7119,  -1835,    483,    -66},
+	{  -124,    705,  -2512,  12576,   7163,  -1844,    486,    -66},
+	{  -124,    705,  -2512,  12539,   7207,  -1853,    489,    -67},
+	{  -124,    705,  -2513,  12503,   7251,  -1862,    491,    -67},
+	{  -124,    705,  -2513,  12467,   7294,  -1871,    494,    -68},
+	{  -123,    704,  -2513,  12429,   7338,  -1880,    497,    -68},
+	{  -123,    704,  -2513,  12393,   7382,  -1889,    499,    -69},
+	{  -123,    704,  -2513,  12356,   7426,  -1898,    502,    -70},
+	{  -123,    703,  -2513,  12319,   7470,  -1907,    505,    -70},
+	{  -122,    703,  -2512,  12281,   7514,  -1916,    507,    -71},
+	{  -122,    703,  -2512,  12243,   7558,  -1925,    510,    -71},
+	{  -122,    702,  -2511,  12205,   7602,  -1933,    513,    -72},
+	{  -122,    702,  -2511,  12168,   7646,  -1942,    515,    -72},
+	{  -121,    701,  -2510,  12130,   7690,  -1951,    518,    -73},
+	{  -121,    701,  -2509,  12092,   7733,  -1960,    521,    -73},
+	{  -121,    700,  -2508,  12055,   7777,  -1968,    523,    -74},
+	{  -120,    700,  -2507,  12015,   7821,  -1977,    526,    -74},
+	{  -120,    699,  -2506,  11978,   7865,  -1985,    528,    -75},
+	{  -120,    699,  -2505,  11939,   7909,  -1994,    531,    -75},
+	{  -119,    698,  -2503,  11900,   7953,  -2002,    533,    -76},
+	{  -119,    697,  -2502,  11861,   7997,  -2010,    536,    -76},
+	{  -119,    697,  -2500,  11823,   8041,  -2019,    538,    -77},
+	{  -118,    696,  -2499,  11784,   8085,  -2027,    541,    -78},
+	{  -118,    695,  -2497,  11746,   8128,  -2035,    543,    -78},
+	{  -118,    694,  -2495,  11707,   8172,  -2043,    546,    -79},
+	{  -117,    693,  -2493,  11668,   8216,  -2052,    548,    -79},
+	{  -117,    693,  -2491,  11628,   8260,  -2060,    551,    -80},
+	{  -117,    692,  -2489,  11589,   8304,  -2068,    553,    -80},
+	{  -116,    691,  -2486,  11549,   8347,  -2076,    556,    -81},
+	{  -116,    690,  -2484,  11510,   8391,  -2084,    558,    -81},
+	{  -116,    689,  -2482,  11470,   8435,  -2091,    561,    -82},
+	{  -115,    688,  -2479,  11429,   8479,  -2099,    563,    -82},
+	{  -115,    687,  -2476,  11390,   8522,  -2107,    566,    -83},
+	{  -115,    686,  -2474,  11351,   8566,  -2115,    568,    -83},
+	{  -114,    685,  -2471,  11310,   8610,  -2122,    570,    -84},
+	{  -114,    684,  -2468,  11270,   8653,  -2130,    573,    -84},
+	{  -113,    683,  -2465,  11230,   8697,  -2138,    575,    -85},
+	{  -113,    681,  -2462,  11190,   8741,  -2145,    577,    -85},
+	{  -113,    680,  -2459,  11150,   8784,  -2152,    580,    -86},
+	{  -112,    679,  -2455,  11108,   8828,  -2160,    582,    -86},
+	{  -112,    678,  -2452,  11069,   8871,  -2167,    584,    -87},
+	{  -111,    677,  -2449,  11028,   8915,  -2174,    586,    -88},
+	{  -111,    675,  -2445,  10988,   8958,  -2182,    589,    -88},
+	{  -111,    674,  -2441,  10947,   9002,  -2189,    591,    -89},
+	{  -110,    673,  -2438,  10906,   9045,  -2196,    593,    -89},
+	{  -110,    671,  -2434,  10867,   9088,  -2203,    595,    -90},
+	{  -109,    670,  -2430,  10823,   9132,  -2210,    598,    -90},
+	{  -109,    669,  -2426,  10783,   9175,  -2217,    600,    -91},
+	{  -108,    667,  -2422,  10741,   9218,  -2223,    602,    -91},
+	{  -108,    666,  -2418,  10701,   9261,  -2230,    604,    -92},
+	{  -108,    664,  -2414,  10660,   9305,  -2237,    606,    -92},
+	{  -107,    663,  -2409,  10618,   9348,  -2244,    608,    -93},
+	{  -107,    661,  -2405,  10577,   9391,  -2250,    610,    -93},
+	{  -106,    660,  -2400,  10535,   9434,  -2257,    612,    -94},
+	{  -106,    658,  -2396,  10494,   9477,  -2263,    614,    -94},
+	{  -105,    657,  -2391,  10450,   9520,  -2269,    617,    -95},
+	{  -105,    655,  -2386,  10409,   9563,  -2276,    619,    -95},
+	{  -104,    653,  -2382,  10368,   9606,  -2282,    621,    -96},
+	{  -104,    652,  -2377,  10326,   9648,  -2288,    623,    -96},
+	{  -103,    650,  -2372,  10285,   9691,  -2294,    624,    -97},
+	{  -103,    648,  -2367,  10243,   9734,  -2300,    626,    -97},
+	{  -103,    647,  -2362,  10201,   9777,  -2306,    628,    -98},
+	{  -102,    645,  -2356,  10158,   9819,  -2312,    630,    -98},
+	{  -102,    643,  -2351,  10117,   9862,  -2318,    632,    -99},
+	{  -101,    641,  -2346,  10075,   9904,  -2324,    634,    -99},
+	{  -101,    640,  -2340,  10031,   9947,  -2329,    636,   -100},
+	{  -100,    638,  -2335,   9989,   9989,  -2335,    638,   -100},
+	{  -100,    636,  -2329,   9947,  10031,  -2340,    640,   -101},
+	{   -99,    634,  -2324,   9904,  10075,  -2346,    641,   -101},
+	{   -99,    632,  -2318,   9862,  10117,  -2351,    643,   -102},
+	{   -98,    630,  -2312,   9819,  10158,  -2356,    645,   -102},
+	{   -98,    628,  -2306,   9777,  10201,  -2362,    647,   -103},
+	{   -97,    626,  -2300,   9734,  10243,  -2367,    648,   -103},
+	{   -97,    624,  -2294,   9691,  10285,  -2372,    650,   -103},
+	{   -96,    623,  -2288,   9648,  10326,  -2377,    652,   -104},
+	{   -96,    621,  -2282,   9606,  10368,  -2382,    653,   -104},
+	{   -95,    619,  -2276,   9563,  10409,  -2386,    655,   -105},
+	{   -95,    617,  -2269,   9520,  10450,  -2391,    657,   -105},
+	{   -94,    614,  -2263,   9477,  10494,  -2396,    658,   -106},
+	{   -94,    612,  -2257,   9434,  10535,  -2400,    660,   -106},
+	{   -93,    610,  -2250,   9391,  10577,  -2405,    661,   -107},
+	{   -93,    608,  -2244,   9348,  10618,  -2409,    663,   -107},
+	{   -92,    606,  -2237,   9305,  10660,  -2414,    664,   -108},
+	{   -92,    604,  -2230,   9261,  10701,  -2418,    666,   -108},
+	{   -91,    602,  -2223,   9218,  10741,  -2422,    667,   -108},
+	{   -91,    600,  -2217,   9175,  10783,  -2426,    669,   -109},
+	{   -90,    598,  -2210,   9132,  10823,  -2430,    670,   -109},
+	{   -90,    595,  -2203,   9088,  10867,  -2434,    671,   -110},
+	{   -89,    593,  -2196,   9045,  10906,  -2438,    673,   -110},
+	{   -89,    591,  -2189,   9002,  10947,  -2441,    674,   -111},
+	{   -88,    589,  -2182,   8958,  10988,  -2445,    675,   -111},
+	{   -88,    586,  -2174,   8915,  11028,  -2449,    677,   -111},
+	{   -87,    584,  -2167,   8871,  11069,  -2452,    678,   -112},
+	{   -86,    582,  -2160,   8828,  11108,  -2455,    679,   -112},
+	{   -86,    580,  -2152,   8784,  11150,  -2459,    680,   -113},
+	{   -85,    577,  -2145,   8741,  11190,  -2462,    681,   -113},
+	{   -85,    575,  -2138,   8697,  11230,  -2465,    683,   -113},
+	{   -84,    573,  -2130,   8653,  11270,  -2468,    684,   -114},
+	{   -84,    570,  -2122,   8610,  11310,  -2471,    685,   -114},
+	{   -83,    568,  -2115,   8566,  11351,  -2474,    686,   -115},
+	{   -83,    566,  -2107,   8522,  11390,  -2476,    687,   -115},
+	{   -82,    563,  -2099,   8479,  11429,  -2479,    688,   -115},
+	{   -82,    561,  -2091,   8435,  11470,  -2482,    689,   -116},
+	{   -81,    558,  -2084,   8391,  11510,  -2484,    690,   -116},
+	{   -81,    556,  -2076,   8347,  11549,  -2486,    691,   -116},
+	{   -80,    553,  -2068,   8304,  11589,  -2489,    692,   -117},
+	{   -80,    551,  -2060,   8260,  11628,  -2491,    693,   -117},
+	{   -79,    548,  -2052,   8216,  11668,  -2493,    693,   -117},
+	{   -79,    546,  -2043,   8172,  11707,  -2495,    694,   -118},
+	{   -78,    543,  -2035,   8128,  11746,  -2497,    695,   -118},
+	{   -78,    541,  -2027,   8085,  11784,  -2499,    696,   -118},
+	{   -77,    538,  -2019,   8041,  11823,  -2500,    697,   -119},
+	{   -76,    536,  -2010,   7997,  11861,  -2502,    697,   -119},
+	{   -76,    533,  -2002,   7953,  11900,  -2503,    698,   -119},
+	{   -75,    531,  -1994,   7909,  11939,  -2505,    699,   -120},
+	{   -75,    528,  -1985,   7865,  11978,  -2506,    699,   -120},
+	{   -74,    526,  -1977,   7821,  12015,  -2507,    700,   -120},
+	{   -74,    523,  -1968,   7777,  12055,  -2508,    700,   -121},
+	{   -73,    521,  -1960,   7733,  12092,  -2509,    701,   -121},
+	{   -73,    518,  -1951,   7690,  12130,  -2510,    701,   -121},
+	{   -72,    515,  -1942,   7646,  12168,  -2511,    702,   -122},
+	{   -72,    513,  -1933,   7602,  12205,  -2511,    702,   -122},
+	{   -71,    510,  -1925,   7558,  12243,  -2512,    703,   -122},
+	{   -71,    507,  -1916,   7514,  12281,  -2512,    703,   -122},
+	{   -70,    505,  -1907,   7470,  12319,  -2513,    703,   -123},
+	{   -70,    502,  -1898,   7426,  12356,  -2513,    704,   -123},
+	{   -69,    499,  -1889,   7382,  12393,  -2513,    704,   -123},
+	{   -68,    497,  -1880,   7338,  12429,  -2513,    704,   -123},
+	{   -68,    494,  -1871,   7294,  12467,  -2513,    705,   -124},
+	{   -67,    491,  -1862,   7251,  12503,  -2513,    705,   -124},
+	{   -67,    489,  -1853,   7207,  12539,  -2512,    705,   -124},
+	{   -66,    486,  -1844,   7163,  12576,  -2512,    705,   -124},
+	{   -66,    483,  -1835,   7119,  12614,  -2511,    705,   -125},
+	{   -65,    481,  -1826,   7075,  12650,  -2511,    705,   -125},
+	{   -65,    478,  -1816,   7031,  12686,  -2510,    705,   -125},
+	{   -64,    475,  -1807,   6988,  12721,  -2509,    705,   -125},
+	{   -64,    472,  -1798,   6944,  12758,  -2508,    705,   -125},
+	{   -63,    470,  -1788,   6900,  12793,  -2507,    705,   -126},
+	{   -63,    467,  -1779,   6856,  12830,  -2506,    705,   -126},
+	{   -62,    464,  -1770,   6813,  12865,  -2505,    705,   -126},
+	{   -62,    461,  -1760,   6769,  12900,  -2503,    705,   -126},
+	{   -61,    459,  -1751,   6725,  12935,  -2502,    705,   -126},
+	{   -61,    456,  -1741,   6681,  12971,  -2500,    704,   -126},
+	{   -60,    453,  -1732,   6638,  13006,  -2498,    704,   -127},
+	{   -60,    450,  -1722,   6594,  13041,  -2496,    704,   -127},
+	{   -59,    447,  -1713,   6551,  13076,  -2494,    703,   -127},
+	{   -59,    445,  -1703,   6507,  13110,  -2492,    703,   -127},
+	{   -58,    442,  -1693,   6463,  13144,  -2490,    703,   -127},
+	{   -57,    439,  -1684,   6420,  13179,  -2488,    702,   -127},
+	{   -57,    436,  -1674,   6376,  13213,  -2485,    702,   -127},
+	{   -56,    433,  -1664,   6333,  13247,  -2483,    701,   -127},
+	{   -56,    431,  -1654,   6289,  13281,  -2480,    701,   -128},
+	{   -55,    428,  -1645,   6246,  13315,  -2477,    700,   -128},
+	{   -55,    425,  -1635,   6203,  13349,  -2474,    699,   -128},
+	{   -54,    422,  -1625,   6159,  13382,  -2471,    699,   -128},
+	{   -54,    419,  -1615,   6116,  13416,  -2468,    698,   -128},
+	{   -53,    416,  -1605,   6073,  13448,  -2464,    697,   -128},
+	{   -53,    414,  -1595,   6029,  13481,  -2461,    697,   -128},
+	{   -52,    411,  -1585,   5986,  13513,  -2457,    696,   -128},
+	{   -52,    408,  -1575,   5943,  13547,  -2454,    695,   -128},
+	{   -51,    405,  -1565,   5900,  13579,  -2450,    694,   -128},
+	{   -51,    402,  -1555,   5857,  13612,  -2446,    693,   -128},
+	{   -50,    399,  -1545,   5814,  13644,  -2442,    692,   -128},
+	{   -50,    396,  -1535,   5771,  13677,  -2438,    691,   -128},
+	{   -49,    394,  -1525,   5728,  13708,  -2434,    690,   -128},
+	{   -49,    391,  -1515,   5685,  13740,  -2429,    689,   -128},
+	{   -48,    388,  -1505,   5642,  13772,  -2425,    688,   -128},
+	{   -48,    385,  -1495,   5599,  13804,  -2420,    687,   -128},
+	{   -47,    382,  -1485,   5556,  13835,  -2415,    686,   -128},
+	{   -47,    379,  -1475,   5514,  13867,  -2410,    684,   -128},
+	{   -47,    376,  -1465,   5471,  13899,  -2405,    683,   -128},
+	{   -46,    374,  -1455,   5428,  13929,  -2400,    682,   -128},
+	{   -46,    371,  -1444,   5386,  13959,  -2395,    681,   -128},
+	{   -45,    368,  -1434,   5343,  13990,  -2389,    679,   -128},
+	{   -45,    365,  -1424,   5301,  14021,  -2384,    678,   -128},
+	{   -44,    362,  -1414,   5258,  14052,  -2378,    676,   -128},
+	{   -44,    359,  -1403,   5216,  14081,  -2372,    675,   -128},
+	{   -43,    356,  -1393,   5173,  14111,  -2366,    673,   -127},
+	{   -43,    353,  -1383,   5131,  14141,  -2360,    672,   -127},
+	{   -42,    351,  -1373,   5089,  14170,  -2354,    670,   -127},
+	{   -42,    348,  -1362,   5047,  14199,  -2347,    668,   -127},
+	{   -41,    345,  -1352,   5005,  14228,  -2341,    667,   -127},
+	{   -41,    342,  -1342,   4962,  14259,  -2334,    665,   -127},
+	{   -40,    339,  -1331,   4920,  14288,  -2328,    663,   -127},
+	{   -40,    336,  -1321,   4879,  14316,  -2321,    661,   -126},
+	{   -39,    333,  -1311,   4837,  14344,  -2314,    660,   -126},
+	{   -39,    330,  -1300,   4795,  14372,  -2306,    658,   -126},
+	{   -39,    328,  -1290,   4753,  14401,  -2299,    656,   -126},
+	{   -38,    325,  -1280,   4711,  14430,  -2292,    654,   -126},
+	{   -38,    322,  -1269,   4670,  14456,  -2284,    652,   -125},
+	{   -37,    319,  -1259,   4628,  14485,  -2277,    650,   -125},
+	{   -37,    316,  -1249,   4587,  14513,  -2269,    648,   -125},
+	{   -36,    313,  -1238,   4545,  14540,  -2261,    646,   -125},
+	{   -36,    310,  -1228,   4504,  14569,  -2253,    643,   -125},
+	{   -35,    308,  -1218,   4463,  14593,  -2244,    641,   -124},
+	{   -35,    305,  -1207,   4421,  14621,  -2236,    639,   -124},
+	{   -35,    302,  -1197,   4380,  14649,  -2228,    637,   -124},
+	{   -34,    299,  -1186,   4339,  14674,  -2219,    634,   -123},
+	{   -34,    296,  -1176,   4298,  14701,  -2210,    632,   -123},
+	{   -33,    293,  -1166,   4257,  14727,  -2201,    630,   -123},
+	{   -33,    290,  -1155,   4216,  14754,  -2192,    627,   -123},
+	{   -32,    288,  -1145,   4176,  14777,  -2183,    625,   -122},
+	{   -32,    285,  -1134,   4135,  14804,  -2174,    622,   -122},
+	{   -32,    282,  -1124,   4094,  14831,  -2164,    619,   -122},
+	{   -31,    279,  -1114,   4054,  14855,  -2155,    617,   -121},
+	{   -31,    276,  -1103,   4013,  14881,  -2145,    614,   -121},
+	{   -30,    274,  -1093,   3973,  14904,  -2135,    611,   -120},
+	{   -30,    271,  -1082,   3932,  14929,  -2125,    609,   -120},
+	{   -30,    268,  -1072,   3892,  14955,  -2115,    606,   -120},
+	{   -29,    265,  -1062,   3852,  14979,  -2105,    603,   -119},
+	{   -29,    262,  -1051,   3812,  15003,  -2094,    600,   -119},
+	{   -28,    260,  -1041,   3772,  15026,  -2084,    597,   -118},
+	{   -28,    257,  -1030,   3732,  15050,  -2073,    594,   -118},
+	{   -28,    254,  -1020,   3692,  15075,  -2062,    591,   -118},
+	{   -27,    251,  -1010,   3652,  15098,  -2051,    588,   -117},
+	{   -27,    248,   -999,   3613,  15121,  -2040,    585,   -117},
+	{   -26,    246,   -989,   3573,  15143,  -2029,    582,   -116},
+	{   -26,    243,   -979,   3534,  15166,  -2017,    579,   -116},
+	{   -26,    240,   -968,   3494,  15189,  -2005,    575,   -115},
+	{   -25,    237,   -958,   3455,  15212,  -1994,    572,   -115},
+	{   -25,    235,   -947,   3416,  15232,  -1982,    569,   -114},
+	{   -25,    232,   -937,   3377,  15256,  -1970,    565,   -114},
+	{   -24,    229,   -927,   3338,  15277,  -1958,    562,   -113},
+	{   -24,    226,   -917,   3299,  15299,  -1945,    559,   -113},
+	{   -23,    224,   -906,   3260,  15319,  -1933,    555,   -112},
+	{   -23,    221,   -896,   3221,  15340,  -1920,    552,   -111},
+	{   -23,    218,   -886,   3182,  15364,  -1908,    548,   -111},
+	{   -22,    216,   -875,   3144,  15382,  -1895,    544,   -110},
+	{   -22,    213,   -865,   3105,  15404,  -1882,    541,   -110},
+	{   -22,    210,   -855,   3067,  15425,  -1869,    537,   -109},
+	{   -21,    208,   -845,   3029,  15443,  -1855,    533,   -108},
+	{   -21,    205,   -834,   2990,  15465,  -1842,    529,   -108},
+	{   -21,    202,   -824,   2952,  15484,  -1828,    526,   -107},
+	{   -20,    199,   -814,   2914,  15504,  -1815,    522,   -106},
+	{   -20,    197,   -804,   2876,  15524,  -1801,    518,   -106},
+	{   -20,    194,   -794,   2839,  15543,  -1787,    514,   -105},
+	{   -19,    192,   -784,   2801,  15560,  -1772,    510,   -104},
+	{   -19,    189,   -773,   2763,  15580,  -1758,    506,   -104},
+	{   -19,    186,   -763,   2726,  15599,  -1744,    502,   -103},
+	{   -18,    184,   -753,   2688,  15617,  -1729,    497,   -102},
+	{   -18,    181,   -743,   2651,  15636,  -1714,    493,   -102},
+	{   -18,    178,   -733,   2614,  15654,  -1699,    489,   -101},
+	{   -17,    176,   -723,   2577,  15670,  -1684,    485,   -100},
+	{   -17,    173,   -713,   2540,  15689,  -1669,    480,    -99},
+	{   -17,    171,   -703,   2503,  15706,  -1654,    476,    -98},
+	{   -16,    168,   -693,   2466,  15723,  -1638,    472,    -98},
+	{   -16,    166,   -683,   2430,  15740,  -1623,    467,    -97},
+	{   -16,    163,   -673,   2393,  15757,  -1607,    463,    -96},
+	{   -15,    160,   -663,   2357,  15773,  -1591,    458,    -95},
+	{   -15,    158,   -653,   2320,  15790,  -1575,    453,    -94},
+	{   -15,    155,   -643,   2284,  15807,  -1559,    449,    -94},
+	{   -15,    153,   -633,   2248,  15822,  -1542,    444,    -93},
+	{   -14,    150,   -623,   2212,  15838,  -1526,    439,    -92},
+	{   -14,    148,   -613,   2176,  15852,  -1509,    435,    -91},
+	{   -14,    145,   -604,   2140,  15869,  -1492,    430,    -90},
+	{   -13,    143,   -594,   2105,  15882,  -1475,    425,    -89},
+	{   -13,    140,   -584,   2069,  15898,  -1458,    420,    -88},
+	{   -13,    138,   -574,   2034,  15912,  -1441,    415,    -87},
+	{   -13,    135,   -564,   1998,  15927,  -1423,    410,    -86},
+	{   -12,    133,   -555,   1963,  15941,  -1406,    405,    -85},
+	{   -12,    131,   -545,   1928,  15954,  -1388,    400,    -84},
+	{   -12,    128,   -535,   1893,  15968,  -1370,    395,    -83},
+	{   -11,    126,   -526,   1858,  15981,  -1352,    390,    -82},
+	{   -11,    123,   -516,   1824,  15995,  -1334,    384,    -81},
+	{   -11,    121,   -506,   1789,  16008,  -1316,    379,    -80},
+	{   -11,    118,   -497,   1754,  16022,  -1297,    374,    -79},
+	{   -10,    116,   -487,   1720,  16033,  -1278,    368,    -78},
+	{   -10,    114,   -478,   1686,  16046,  -1260,    363,    -77},
+	{   -10,    111,   -468,   1652,  16058,  -1241,    358,    -76},
+	{   -10,    109,   -459,   1618,  16071,  -1222,    352,    -75},
+	{    -9,    107,   -449,   1584,  16081,  -1203,    347,    -74},
+	{    -9,    104,   -440,   1550,  16094,  -1183,    341,    -73},
+	{    -9,    102,   -430,   1516,  16106,  -1164,    335,    -72},
+	{    -9,    100,   -421,   1483,  16116,  -1144,    330,    -71},
+	{    -8,     97,   -412,   1449,  16127,  -1124,    324,    -69},
+	{    -8,     95,   -402,   1416,  16137,  -1104,    318,    -68},
+	{    -8,     93,   -393,   1383,  16148,  -1084,    312,    -67},
+	{    -8,     91,   -384,   1350,  16158,  -1064,    307,    -66},
+	{    -8,     88,   -375,   1317,  16169,  -1043,    301,    -65},
+	{    -7,     86,   -365,   1284,  16178,  -1023,    295,    -64},
+	{    -7,     84,   -356,   1252,  16186,  -1002,    289,    -62},
+	{    -7,     82,   -347,   1219,  16196,   -981,    283,    -61},
+	{    -7,     79,   -338,   1187,  16206,   -960,    277,    -60},
+	{    -6,     77,   -329,   1154,  16215,   -939,    271,    -59},
+	{    -6,     75,   -320,   1122,  16223,   -918,    265,    -57},
+	{    -6,     73,   -311,   1090,  16232,   -896,    258,    -56},
+	{    -6,     71,   -302,   1058,  16241,   -875,    252,    -55},
+	{    -6,     68,   -293,   1027,  16248,   -853,    246,    -53},
+	{    -5,     66,   -284,    995,  16255,   -831,    240,    -52},
+	{    -5,     64,   -275,    964,  16263,   -809,    233,    -51},
+	{    -5,     62,   -266,    932,  16271,   -787,    227,    -50},
+	{    -5,     60,   -257,    901,  16278,   -765,    220,    -48},
+	{    -5,     58,   -248,    870,  16284,   -742,    214,    -47},
+	{    -4,     56,   -240,    839,  16291,   -720,    207,    -45},
+	{    -4,     54,   -231,    808,  16297,   -697,    201,    -44},
+	{    -4,     52,   -222,    777,  16304,   -674,    194,    -43},
+	{    -4,     49,   -213,    747,  16310,   -651,    187,    -41},
+	{    -4,     47,   -205,    716,  16317,   -628,    181,    -40},
+	{    -4,     45,   -196,    686,  16321,   -604,    174,    -38},
+	{    -3,     43,   -188,    656,  16327,   -581,    167,    -37},
+	{    -3,     41,   -179,    626,  16331,   -557,    160,    -35},
+	{    -3,     39,   -171,    596,  16336,   -533,    154,    -34},
+	{    -3,     37,   -162,    566,  16340,   -509,    147,    -32},
+	{    -3,     35,   -154,    537,  16345,   -485,    140,    -31},
+	{    -3,     33,   -145,    507,  16349,   -461,    133,    -29},
+	{    -2,     31,   -137,    478,  16353,   -437,    126,    -28},
+	{    -2,     29,   -128,    448,  16356,   -412,    119,    -26},
+	{    -2,     28,   -120,    419,  16360,   -387,    111,    -25},
+	{    -2,     26,   -112,    390,  16364,   -363,    104,    -23},
+	{    -2,     24,   -104,    362,  16367,   -338,     97,    -22},
+	{    -2,     22,    -95,    333,  16369,   -313,     90,    -20},
+	{    -1,     20,    -87,    304,  16370,   -287,     83,    -18},
+	{    -1,     18,    -79,    276,  16374,   -262,     75,    -17},
+	{    -1,     16,    -71,    248,  16375,   -236,     68,    -15},
+	{    -1,     14,    -63,    220,  16378,   -211,     61,    -14},
+	{    -1,     13,    -55,    192,  16379,   -185,     53,    -12},
+	{    -1,     11,    -47,    164,  16380,   -159,     46,    -10},
+	{    -1,      9,    -39,    136,  16383,   -133,     38,     -9},
+	{     0,      7,    -31,    109,  16381,   -106,     31,     -7},
+	{     0,      5,    -23,     81,  16383,    -80,     23,     -5},
+	{     0,      4,    -16,     54,  16384,    -54,     15,     -3},
+	{     0,      2,     -8,     27,  16384,    -27,      8,     -2},
+};
@@ -0,0 +1,109 @@
+# Audio Library for Teensy 3.X
+# Copyright (c) 2017, TeensyAudio PSU Team
+#
+# Development of this audio library was sponsored by PJRC.COM, LLC.
+# Please support PJRC's efforts to develop open source 
+# software by purchasing Teensy or other PJRC products.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice, development funding notice, and this permission
+# notice shall be included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+
+# Python script generating the fixed-point coefficient tables used by the
+# higher-order interpolation modes of AudioSynthWavetable.
+#
+#   python3 interpolation_tables.py > interpolation_tables.cpp
+#
+# Each table has one row per phase fraction (the top *_TABLE_BITS bits of the
+# fraction between two sample indices) and one Q14 coefficient per tap. Rows
+# are rounded so their coefficients sum to exactly 1.0, and the row for a
+# zero fraction passes the sample through unchanged.
+import math
+import sys
+
+INTERPOLATION_COEFFICIENT_BITS = 14
+HERMITE_TABLE_BITS = 8
+SINC_TABLE_BITS = 9
+SINC_TAPS = 8
+SINC_KAISER_BETA = 6.0
+
+
+# 4-point, 3rd-order Hermite (Catmull-Rom) weights for samples [-1, 0, 1, 2]
+def hermite_weights(t):
+    return [(-t * t * t + 2 * t * t - t) / 2,
+            (3 * t * t * t - 5 * t * t + 2) / 2,
+            (-3 * t * t * t + 4 * t * t + t) / 2,
+            (t * t * t - t * t) / 2]
+
+
+def bessel_i0(x):
+    total, term, k = 1.0, 1.0, 1
+    while term > 1e-12 * total:
+        term *= (x / (2 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+# Kaiser-windowed sinc weights for samples [-3, ..., 4]
+def sinc_weights(t):
+    half = SINC_TAPS // 2
+    weights = []
+    for k in range(1 - half, half + 1):
+        x = t - k
+        sinc = 1.0 if x == 0 else math.sin(math.pi * x) / (math.pi * x)
+        r = x / half
+        window = bessel_i0(SINC_KAISER_BETA * math.sqrt(1 - r * r)) / bessel_i0(SINC_KAISER_BETA) if abs(r) < 1 else 0.0
+        weights.append(sinc * window)
+    return weights
+
+
+# rounds a row to Q14 and puts the rounding error on the largest tap, so the
+# row sums to unity gain
+def quantize(weights):
+    total = sum(weights)
+    unity = 1 << INTERPOLATION_COEFFICIENT_BITS
+    row = [int(round(w / total * unity)) for w in weights]
+    row[max(range(len(row)), key=lambda i: abs(weights[i]))] += unity - sum(row)
+    return row
+
+
+def emit_table(name, bits, taps, weights):
+    print("const int16_t {}[{}][{}] = {{".format(name, 1 << bits, taps))
+    for i in range(1 << bits):
+        row = quantize(weights(i / float(1 << bits)))
+        print("\t{{{}}},".format(", ".join("{:6d}".format(c) for c in row)))
+    print("};")
+
+
+def main():
+    print("// Generated by interpolation_tables.py -- do not edit.")
+    print("#include \"wavetable_kernels.h\"")
+    print("")
+    print("#if INTERPOLATION_COEFFICIENT_BITS != {} || HERMITE_TABLE_BITS != {} || SINC_TABLE_BITS != {} || SINC_TAPS != {}"
+          .format(INTERPOLATION_COEFFICIENT_BITS, HERMITE_TABLE_BITS, SINC_TABLE_BITS, SINC_TAPS))
+    print("#error \"interpolation_tables.cpp is out of date, rerun interpolation_tables.py\"")
+    print("#endif")
+    print("")
+    emit_table("hermite_table", HERMITE_TABLE_BITS, 4, hermite_weights)
+    print("")
+    emit_table("sinc_table", SINC_TABLE_BITS, SINC_TAPS, sinc_weights)
+
+
+if __name__ == "__main__":
+    main()
@@ -27,9 +27,25 @@
 #pragma once
 #include <stdint.h>
 
-#define CENTS_SHIFT(C) (pow(2.0, C/1200.0))
-#define NOTE(N) (440.0 * pow(2.0, (N - 69) / 12.0))
-#define DECIBEL_SHIFT(dB) (pow(10.0, dB/20.0))
+// Sum of the Taylor series of e^y from its 'k'th term on, 'term' being that
+// term's value; 24 terms are exact to a double's precision for |y| <= ln(2)/2.
+constexpr double wavetable_exp_series(double y, double term, int k) {
+	return k > 24 ? term : term + wavetable_exp_series(y, term * y / k, k + 1);
+}
+
+// 2^x as a constant expression, so the macros below leave decoded instruments
+// constant-initialized in flash rather than computed by startup code.
+constexpr double wavetable_exp2(double x) {
+	return x > 0.5 ? 2.0 * wavetable_exp2(x - 1.0) : x < -0.5 ? 0.5 * wavetable_exp2(x + 1.0)
+		: wavetable_exp_series(x * 0.69314718055994531, 1.0, 1);
+}
+
+#define CENTS_SHIFT(C) (wavetable_exp2((C)/1200.0))
+#define NOTE(N) (440.0 * wavetable_exp2(((N) - 69) / 12.0))
+#define DECIBEL_SHIFT(dB) (wavetable_exp2((dB)/20.0 * 3.3219280948873623))
+
+static_assert(CENTS_SHIFT(1200) == 2.0 && NOTE(69) == 440.0, "CENTS_SHIFT and NOTE must be constant expressions");
+static_assert(DECIBEL_SHIFT(-20) > 0.0999999999 && DECIBEL_SHIFT(-20) < 0.1000000001, "DECIBEL_SHIFT must be a constant expression");
 
 struct sample_data {
 	// SAMPLE VALUES
@@ -63,10 +79,30 @@ struct sample_data {
 	const float MODULATION_PITCH_COEFFICIENT_SECOND;
 	const int32_t MODULATION_AMPLITUDE_INITIAL_GAIN;
 	const int32_t MODULATION_AMPLITUDE_SECOND_GAIN;
+
+	// MIP LEVELS AND PADDING (left zero by decoder output that predates them)
+	const int MIP_LEVELS;	// number of decimated copies in MIP_SAMPLES, 0 if none
+	const int16_t* const* MIP_SAMPLES;	// MIP_SAMPLES[k-1]: 'sample' band-limited and decimated by 2^k
+	const int GUARD_SAMPLES;	// padding before the start and after the loop end (or end) of every level
 };
 
+// A sanity check the decoder's output static_asserts for every sample, which
+// also makes the compiler prove the sample_data is a constant expression.
+constexpr bool sample_data_valid(const sample_data& s) {
+	return s.sample != nullptr && s.INDEX_BITS > 0 && s.INDEX_BITS < 32 && s.MIP_LEVELS >= 0
+		&& (s.MIP_LEVELS == 0 || s.MIP_SAMPLES != nullptr) && s.GUARD_SAMPLES >= 0;
+}
+
+#define NOTE_COUNT 128
+
 struct instrument_data {
 	const uint8_t sample_count;
-	const uint8_t* sample_note_ranges;
+	const uint8_t* sample_note_ranges;	// highest note of each sample, ascending
 	const sample_data* samples;
+	// Zone map: the index into samples that plays each note at each velocity,
+	// note_samples[note * velocity_band_count + velocity_bands[velocity]].
+	// NULL in decoder output that predates it.
+	const uint8_t* note_samples;
+	const uint8_t velocity_band_count;	// 1 (or 0) if no sample is limited to a velocity range
+	const uint8_t* velocity_bands;	// band of each of the 128 velocities, NULL if there is one band
 };
@@ -0,0 +1,165 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <sample_data.h>
+
+// Control events for AudioSynthWavetable.
+//
+// playNote(), stop(), amplitude() and setInstrument() may be called from the
+// main loop, from USB MIDI callbacks, from timer interrupts or, on a host,
+// from other threads. Rather than touching the voice's playback state with
+// interrupts disabled, each call posts an event to the voice's queue, and
+// render() applies the pending events in order at the start of the next
+// block. Only render() ever changes the playback state. An event may name
+// a sample offset within that block, at which render() splits the block and
+// applies it, so a note can start on any sample rather than on a block
+// boundary.
+//
+// A note event carries the note's whole wavetable_note_spec, worked out by
+// playNote() on the caller's side; the queue slot it travels in is written
+// before it is published and read after, like one half of a double buffer.
+//
+// WavetableQueue is a bounded multi-producer, single-consumer queue
+// (after Vyukov's bounded MPMC queue). A producer claims a slot with one
+// compare-and-swap and publishes it through the slot's sequence number, so
+// a producer interrupted half-way by another only delays its own event and
+// never blocks anyone. Needs lock-free 32-bit atomics, as on the Teensy 3.x
+// (LDREX/STREX) and every desktop host. The same queue carries idle
+// notifications from voices to a WavetableVoiceManager.
+
+#define WAVETABLE_EVENT_QUEUE_SIZE 8 // events a voice holds between blocks, a power of two
+
+enum wavetableEventEnum { EVENT_NOTE, EVENT_STOP, EVENT_SILENCE, EVENT_AMPLITUDE, EVENT_STEAL, EVENT_KILL };
+
+// The parameters of a note, fixed from note-on to the end of its release.
+struct wavetable_note_spec {
+	const sample_data* sample;     // the sample to play, from the zone map
+	uint32_t tone_incr;            // phase increment per output sample
+	int32_t vib_pitch_offset_init; // vibrato depth either side of the pitch
+	int32_t vib_pitch_offset_scnd;
+	int32_t mod_pitch_offset_init; // modulation depth either side of the pitch
+	int32_t mod_pitch_offset_scnd;
+	uint16_t tone_amp;             // velocity and sample attenuation
+	uint8_t mip_level;             // the band-limited copy to play, 0 for the sample
+};
+
+struct wavetable_event {
+	uint8_t type;              // a wavetableEventEnum
+	uint16_t amplitude;        // EVENT_AMPLITUDE: 0-UINT16_MAX
+	uint8_t offset;            // sample of the next block to apply it at
+	wavetable_note_spec note;  // EVENT_NOTE, EVENT_STEAL
+};
+
+template <class T, uint32_t SIZE>
+class WavetableQueue
+{
+public:
+	WavetableQueue(void) {
+		for (uint32_t i = 0; i < SIZE; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Post an event; safe from any number of threads and interrupts.
+	 *
+	 * @param event the event to copy into the queue
+	 * @return false if the queue is full, and the event was dropped
+	 */
+	bool push(const T& event) {
+		uint32_t pos = tail.load(std::memory_order_relaxed);
+		for (;;) {
+			slot& s = slots[pos % SIZE];
+			int32_t lag = (int32_t)(s.sequence.load(std::memory_order_acquire) - pos);
+			if (lag < 0) return false; // the consumer has not freed this slot yet
+			if (lag == 0 && tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				s.event = event;
+				s.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+			// another producer claimed the slot first; 'pos' is reloaded
+			if (lag > 0) pos = tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Take the oldest event; only the consumer (for a voice's events,
+	 * its render()) may call this.
+	 *
+	 * @param event filled with the event
+	 * @return false if no event is pending, or the oldest one is still being
+	 * posted (it is then taken at the next block)
+	 */
+	bool pop(T& event) {
+		slot& s = slots[head % SIZE];
+		if (s.sequence.load(std::memory_order_acquire) != head + 1) return false;
+		event = s.event;
+		s.sequence.store(head + SIZE, std::memory_order_release);
+		++head;
+		return true;
+	}
+
+	/**
+	 * @brief Whether no event is ready to pop; consumer only.
+	 */
+	bool empty(void) const {
+		return slots[head % SIZE].sequence.load(std::memory_order_acquire) != head + 1;
+	}
+
+private:
+	static_assert((SIZE & (SIZE - 1)) == 0, "queue size must be a power of two");
+
+	struct slot {
+		std::atomic<uint32_t> sequence;
+		T event;
+	};
+
+	slot slots[SIZE];
+	std::atomic<uint32_t> tail{0}; // next position producers claim
+	uint32_t head = 0;             // next position the consumer takes
+};
+
+typedef WavetableQueue<wavetable_event, WAVETABLE_EVENT_QUEUE_SIZE> WavetableEventQueue;
+
+/**
+ * @brief Told when a voice falls silent: its release ends, a one-shot sample
+ * plays out, it drops below its idle floor or is cut off.
+ */
+class WavetableIdleListener
+{
+public:
+	virtual ~WavetableIdleListener(void) {}
+
+	/**
+	 * @brief Called from render(), i.e. the audio interrupt (or, on a host,
+	 * a render thread), so it must only note the voice and return.
+	 *
+	 * @param id the voice's id, given to AudioSynthWavetable::setIdleListener()
+	 */
+	virtual void voiceIdle(int id) = 0;
+};
@@ -0,0 +1,614 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "wavetable_kernels.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// The vector kernels work on 16-bit lanes and reproduce the scalar dspinst.h
+// arithmetic exactly:
+//  - signed_multiply_32x16t/b(scale, x) with 0 <= scale <= 0xFFFF is the high
+//    half of an unsigned-by-signed 16x16 product;
+//  - the interpolated value is only ever used through its low halfword, so
+//    it can wrap in a 16-bit lane;
+//  - the low halfword of signed_multiply_32x16b(amp, s) is bits 16..31 of
+//    amp * s, i.e. (amp_hi * s) + high(amp_lo * s) modulo 2^16;
+//  - the envelope gain env_mult >> 15 is applied the same way, with a
+//    different gain in each lane.
+// Each kernel is a template on ENVELOPE, which fuses the envelope ramp into
+// the loop so the interpolated value is scaled before it is ever stored.
+
+#if defined(WAVETABLE_SIMD)
+static void interpolate_scalar(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp)
+{
+	wavetable_interpolate_scalar(out, count, phase, incr, sample, index_bits, amp);
+}
+
+static void interpolate_envelope_scalar(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	wavetable_interpolate_envelope_scalar(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+}
+
+template <bool ENVELOPE>
+static inline void interpolate_tail(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	if (ENVELOPE) wavetable_interpolate_envelope_scalar(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+	else wavetable_interpolate_scalar(out, count, phase, incr, sample, index_bits, amp);
+}
+#endif
+
+#if defined(__SSE2__)
+// high half of unsigned u times signed s, per 16-bit lane
+static inline __m128i mulhi_u16_s16(__m128i u, __m128i s)
+{
+	return _mm_sub_epi16(_mm_mulhi_epu16(u, s), _mm_and_si128(_mm_srai_epi16(s, 15), u));
+}
+
+// packs the low halfwords of eight 32-bit lanes holding values below 0x10000
+static inline __m128i pack_low_u16(__m128i a, __m128i b)
+{
+	a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+	b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+	return _mm_packs_epi32(a, b);
+}
+
+// scales eight interpolated values by amp, then (with ENVELOPE) by the
+// envelope gains env0 (lanes 0-3) and env1 (lanes 4-7)
+template <bool ENVELOPE>
+static inline __m128i apply_gain_sse2(__m128i s, __m128i amp_hi, __m128i amp_lo, __m128i env0, __m128i env1)
+{
+	s = _mm_add_epi16(_mm_mullo_epi16(amp_hi, s), mulhi_u16_s16(amp_lo, s));
+	if (ENVELOPE) {
+		__m128i gain0 = _mm_srai_epi32(env0, 15), gain1 = _mm_srai_epi32(env1, 15);
+		__m128i gain_hi = pack_low_u16(_mm_srai_epi32(gain0, 16), _mm_srai_epi32(gain1, 16));
+		s = _mm_add_epi16(_mm_mullo_epi16(gain_hi, s), mulhi_u16_s16(pack_low_u16(gain0, gain1), s));
+	}
+	return s;
+}
+
+template <bool ENVELOPE>
+static void interpolate_sse2(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	const __m128i shift_index = _mm_cvtsi32_si128(32 - index_bits);
+	const __m128i shift_scale = _mm_cvtsi32_si128(index_bits);
+	const __m128i step = _mm_set1_epi32(incr * 8);
+	const __m128i ones = _mm_set1_epi16(-1);
+	const __m128i amp_hi = _mm_set1_epi16(amp >> 16);
+	const __m128i amp_lo = _mm_set1_epi16(amp & 0xFFFF);
+	__m128i ph0 = _mm_setr_epi32(phase, phase + incr, phase + 2 * incr, phase + 3 * incr);
+	__m128i ph1 = _mm_add_epi32(ph0, _mm_set1_epi32(incr * 4));
+	// the envelope steps before each sample, so lane k sees env_mult + (k + 1) * env_incr
+	const __m128i env_step = _mm_set1_epi32((uint32_t)env_incr * 8);
+	__m128i env0 = _mm_add_epi32(_mm_set1_epi32(env_mult),
+		_mm_setr_epi32(env_incr, (uint32_t)env_incr * 2, (uint32_t)env_incr * 3, (uint32_t)env_incr * 4));
+	__m128i env1 = _mm_add_epi32(env0, _mm_set1_epi32((uint32_t)env_incr * 4));
+
+	for (; count >= 8; count -= 8, out += 8) {
+		uint32_t index[8] __attribute__((aligned(16)));
+		_mm_store_si128((__m128i*)index, _mm_srl_epi32(ph0, shift_index));
+		_mm_store_si128((__m128i*)(index + 4), _mm_srl_epi32(ph1, shift_index));
+		__m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+#define LOAD_LANE(k) \
+		lo = _mm_insert_epi16(lo, sample[index[k]], k); \
+		hi = _mm_insert_epi16(hi, sample[index[k] + 1], k);
+		LOAD_LANE(0) LOAD_LANE(1) LOAD_LANE(2) LOAD_LANE(3)
+		LOAD_LANE(4) LOAD_LANE(5) LOAD_LANE(6) LOAD_LANE(7)
+#undef LOAD_LANE
+		__m128i scale = pack_low_u16(_mm_srli_epi32(_mm_sll_epi32(ph0, shift_scale), 16),
+			_mm_srli_epi32(_mm_sll_epi32(ph1, shift_scale), 16));
+		__m128i s = _mm_add_epi16(mulhi_u16_s16(scale, hi),
+			mulhi_u16_s16(_mm_xor_si128(scale, ones), lo));
+		s = apply_gain_sse2<ENVELOPE>(s, amp_hi, amp_lo, env0, env1);
+		if (ENVELOPE) {
+			env0 = _mm_add_epi32(env0, env_step);
+			env1 = _mm_add_epi32(env1, env_step);
+			env_mult += (uint32_t)env_incr * 8;
+		}
+		_mm_storeu_si128((__m128i*)out, s);
+		ph0 = _mm_add_epi32(ph0, step);
+		ph1 = _mm_add_epi32(ph1, step);
+		phase += incr * 8;
+	}
+	interpolate_tail<ENVELOPE>(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i mulhi_u16_s16_avx2(__m256i u, __m256i s)
+{
+	return _mm256_sub_epi16(_mm256_mulhi_epu16(u, s), _mm256_and_si256(_mm256_srai_epi16(s, 15), u));
+}
+
+// packs sixteen 32-bit lanes holding values below 0x10000 into 16-bit lanes, in order
+__attribute__((target("avx2")))
+static inline __m256i pack_u16_avx2(__m256i a, __m256i b)
+{
+	return _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+}
+
+// apply_gain_sse2() for sixteen lanes
+template <bool ENVELOPE>
+__attribute__((target("avx2")))
+static inline __m256i apply_gain_avx2(__m256i s, __m256i amp_hi, __m256i amp_lo, __m256i env0, __m256i env1)
+{
+	const __m256i low_mask = _mm256_set1_epi32(0xFFFF);
+	s = _mm256_add_epi16(_mm256_mullo_epi16(amp_hi, s), mulhi_u16_s16_avx2(amp_lo, s));
+	if (ENVELOPE) {
+		__m256i gain0 = _mm256_srai_epi32(env0, 15), gain1 = _mm256_srai_epi32(env1, 15);
+		__m256i gain_hi = pack_u16_avx2(_mm256_srli_epi32(gain0, 16), _mm256_srli_epi32(gain1, 16));
+		__m256i gain_lo = pack_u16_avx2(_mm256_and_si256(gain0, low_mask), _mm256_and_si256(gain1, low_mask));
+		s = _mm256_add_epi16(_mm256_mullo_epi16(gain_hi, s), mulhi_u16_s16_avx2(gain_lo, s));
+	}
+	return s;
+}
+
+template <bool ENVELOPE>
+__attribute__((target("avx2")))
+static void interpolate_avx2(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	const __m128i shift_index = _mm_cvtsi32_si128(32 - index_bits);
+	const __m128i shift_scale = _mm_cvtsi32_si128(index_bits);
+	const __m256i step = _mm256_set1_epi32(incr * 16);
+	const __m256i low_mask = _mm256_set1_epi32(0xFFFF);
+	const __m256i ones = _mm256_set1_epi16(-1);
+	const __m256i amp_hi = _mm256_set1_epi16(amp >> 16);
+	const __m256i amp_lo = _mm256_set1_epi16(amp & 0xFFFF);
+	__m256i ph0 = _mm256_add_epi32(_mm256_set1_epi32(phase),
+		_mm256_mullo_epi32(_mm256_set1_epi32(incr), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+	__m256i ph1 = _mm256_add_epi32(ph0, _mm256_set1_epi32(incr * 8));
+	const __m256i env_step = _mm256_set1_epi32((uint32_t)env_incr * 16);
+	__m256i env0 = _mm256_add_epi32(_mm256_set1_epi32(env_mult),
+		_mm256_mullo_epi32(_mm256_set1_epi32(env_incr), _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8)));
+	__m256i env1 = _mm256_add_epi32(env0, _mm256_set1_epi32((uint32_t)env_incr * 8));
+
+	for (; count >= 16; count -= 16, out += 16) {
+		// each gather lane reads the pair sample[index], sample[index + 1]
+		__m256i pair0 = _mm256_i32gather_epi32((const int*)sample, _mm256_srl_epi32(ph0, shift_index), 2);
+		__m256i pair1 = _mm256_i32gather_epi32((const int*)sample, _mm256_srl_epi32(ph1, shift_index), 2);
+		__m256i lo = pack_u16_avx2(_mm256_and_si256(pair0, low_mask), _mm256_and_si256(pair1, low_mask));
+		__m256i hi = pack_u16_avx2(_mm256_srli_epi32(pair0, 16), _mm256_srli_epi32(pair1, 16));
+		__m256i scale = pack_u16_avx2(_mm256_srli_epi32(_mm256_sll_epi32(ph0, shift_scale), 16),
+			_mm256_srli_epi32(_mm256_sll_epi32(ph1, shift_scale), 16));
+		__m256i s = _mm256_add_epi16(mulhi_u16_s16_avx2(scale, hi),
+			mulhi_u16_s16_avx2(_mm256_xor_si256(scale, ones), lo));
+		s = apply_gain_avx2<ENVELOPE>(s, amp_hi, amp_lo, env0, env1);
+		if (ENVELOPE) {
+			env0 = _mm256_add_epi32(env0, env_step);
+			env1 = _mm256_add_epi32(env1, env_step);
+			env_mult += (uint32_t)env_incr * 16;
+		}
+		_mm256_storeu_si256((__m256i*)out, s);
+		ph0 = _mm256_add_epi32(ph0, step);
+		ph1 = _mm256_add_epi32(ph1, step);
+		phase += incr * 16;
+	}
+	// the tail runs legacy-SSE code, which stalls on dirty upper halves
+	_mm256_zeroupper();
+	interpolate_sse2<ENVELOPE>(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+}
+
+// The exact-ratio copy for steps of one sample (a copy) and two (an octave
+// up); other steps are rare enough to leave to the scalar loop. An octave-up
+// vector loads one sample past the last one it uses, so the final vector is
+// left to the scalar loop to keep unguarded samples from reading off the end.
+static void copy_sse2(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	const __m128i amp_hi = _mm_set1_epi16(amp >> 16);
+	const __m128i amp_lo = _mm_set1_epi16(amp & 0xFFFF);
+	const __m128i neg_bias = _mm_set1_epi16(-bias);
+	const __m128i env_step = _mm_set1_epi32((uint32_t)env_incr * 8);
+	__m128i env0 = _mm_add_epi32(_mm_set1_epi32(env_mult),
+		_mm_setr_epi32(env_incr, (uint32_t)env_incr * 2, (uint32_t)env_incr * 3, (uint32_t)env_incr * 4));
+	__m128i env1 = _mm_add_epi32(env0, _mm_set1_epi32((uint32_t)env_incr * 4));
+
+	if (step == 1 || step == 2) {
+		const int reserve = step == 2;
+		for (; count >= 8 + reserve; count -= 8, out += 8, index += 8 * step) {
+			__m128i x = _mm_loadu_si128((const __m128i*)(sample + index));
+			if (step == 2) x = pack_low_u16(x, _mm_loadu_si128((const __m128i*)(sample + index + 8)));
+			x = _mm_add_epi16(x, _mm_and_si128(_mm_cmpgt_epi16(x, _mm_setzero_si128()), neg_bias));
+			_mm_storeu_si128((__m128i*)out, apply_gain_sse2<true>(x, amp_hi, amp_lo, env0, env1));
+			env0 = _mm_add_epi32(env0, env_step);
+			env1 = _mm_add_epi32(env1, env_step);
+			env_mult += (uint32_t)env_incr * 8;
+		}
+	}
+	wavetable_copy_envelope_scalar(out, count, index, step, sample, bias, amp, env_mult, env_incr);
+}
+
+__attribute__((target("avx2")))
+static void copy_avx2(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	const __m256i low_mask = _mm256_set1_epi32(0xFFFF);
+	const __m256i amp_hi = _mm256_set1_epi16(amp >> 16);
+	const __m256i amp_lo = _mm256_set1_epi16(amp & 0xFFFF);
+	const __m256i neg_bias = _mm256_set1_epi16(-bias);
+	const __m256i env_step = _mm256_set1_epi32((uint32_t)env_incr * 16);
+	__m256i env0 = _mm256_add_epi32(_mm256_set1_epi32(env_mult),
+		_mm256_mullo_epi32(_mm256_set1_epi32(env_incr), _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8)));
+	__m256i env1 = _mm256_add_epi32(env0, _mm256_set1_epi32((uint32_t)env_incr * 8));
+
+	if (step == 1 || step == 2) {
+		const int reserve = step == 2;
+		for (; count >= 16 + reserve; count -= 16, out += 16, index += 16 * step) {
+			__m256i x = _mm256_loadu_si256((const __m256i*)(sample + index));
+			if (step == 2) x = pack_u16_avx2(_mm256_and_si256(x, low_mask),
+				_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(sample + index + 16)), low_mask));
+			x = _mm256_add_epi16(x, _mm256_and_si256(_mm256_cmpgt_epi16(x, _mm256_setzero_si256()), neg_bias));
+			_mm256_storeu_si256((__m256i*)out, apply_gain_avx2<true>(x, amp_hi, amp_lo, env0, env1));
+			env0 = _mm256_add_epi32(env0, env_step);
+			env1 = _mm256_add_epi32(env1, env_step);
+			env_mult += (uint32_t)env_incr * 16;
+		}
+	}
+	_mm256_zeroupper();
+	copy_sse2(out, count, index, step, sample, bias, amp, env_mult, env_incr);
+}
+#endif // __SSE2__
+
+#if defined(__ARM_NEON)
+template <bool ENVELOPE>
+static void interpolate_neon(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	const int32x4_t shift_index = vdupq_n_s32(index_bits - 32);
+	const int32x4_t shift_scale = vdupq_n_s32(index_bits);
+	const uint32x4_t step = vdupq_n_u32(incr * 8);
+	const int32x4_t scale_max = vdupq_n_s32(0xFFFF);
+	const int32x4_t vamp = vdupq_n_s32(amp);
+	const uint32_t start[4] = { phase, phase + incr, phase + 2 * incr, phase + 3 * incr };
+	uint32x4_t ph0 = vld1q_u32(start);
+	uint32x4_t ph1 = vaddq_u32(ph0, vdupq_n_u32(incr * 4));
+	const uint32_t env_start[4] = { env_mult + (uint32_t)env_incr, env_mult + (uint32_t)env_incr * 2,
+		env_mult + (uint32_t)env_incr * 3, env_mult + (uint32_t)env_incr * 4 };
+	const int32x4_t env_step = vdupq_n_s32((uint32_t)env_incr * 8);
+	const int32x4_t gain_mask = vdupq_n_s32(0xFFFF);
+	int32x4_t env0 = vreinterpretq_s32_u32(vld1q_u32(env_start));
+	int32x4_t env1 = vaddq_s32(env0, vdupq_n_s32((uint32_t)env_incr * 4));
+
+	for (; count >= 8; count -= 8, out += 8) {
+		uint32_t index[8];
+		int32_t lo[8], hi[8];
+		vst1q_u32(index, vshlq_u32(ph0, shift_index));
+		vst1q_u32(index + 4, vshlq_u32(ph1, shift_index));
+		for (int k = 0; k < 8; ++k) {
+			lo[k] = sample[index[k]];
+			hi[k] = sample[index[k] + 1];
+		}
+		int32x4_t sc0 = vreinterpretq_s32_u32(vshrq_n_u32(vshlq_u32(ph0, shift_scale), 16));
+		int32x4_t sc1 = vreinterpretq_s32_u32(vshrq_n_u32(vshlq_u32(ph1, shift_scale), 16));
+		int32x4_t s0 = vaddq_s32(vshrq_n_s32(vmulq_s32(sc0, vld1q_s32(hi)), 16),
+			vshrq_n_s32(vmulq_s32(vsubq_s32(scale_max, sc0), vld1q_s32(lo)), 16));
+		int32x4_t s1 = vaddq_s32(vshrq_n_s32(vmulq_s32(sc1, vld1q_s32(hi + 4)), 16),
+			vshrq_n_s32(vmulq_s32(vsubq_s32(scale_max, sc1), vld1q_s32(lo + 4)), 16));
+		// only the low halfword of the interpolated value is used
+		s0 = vshrq_n_s32(vshlq_n_s32(s0, 16), 16);
+		s1 = vshrq_n_s32(vshlq_n_s32(s1, 16), 16);
+		int16x4_t r0 = vmovn_s32(vshrq_n_s32(vmulq_s32(vamp, s0), 16));
+		int16x4_t r1 = vmovn_s32(vshrq_n_s32(vmulq_s32(vamp, s1), 16));
+		if (ENVELOPE) {
+			// gain * x split into its high and (unsigned) low halfword products
+			// so neither overflows 32 bits
+			int32x4_t gain0 = vshrq_n_s32(env0, 15), gain1 = vshrq_n_s32(env1, 15);
+			int32x4_t x0 = vmovl_s16(r0), x1 = vmovl_s16(r1);
+			r0 = vmovn_s32(vaddq_s32(vmulq_s32(vshrq_n_s32(gain0, 16), x0),
+				vshrq_n_s32(vmulq_s32(vandq_s32(gain0, gain_mask), x0), 16)));
+			r1 = vmovn_s32(vaddq_s32(vmulq_s32(vshrq_n_s32(gain1, 16), x1),
+				vshrq_n_s32(vmulq_s32(vandq_s32(gain1, gain_mask), x1), 16)));
+			env0 = vaddq_s32(env0, env_step);
+			env1 = vaddq_s32(env1, env_step);
+			env_mult += (uint32_t)env_incr * 8;
+		}
+		vst1q_s16(out, vcombine_s16(r0, r1));
+		ph0 = vaddq_u32(ph0, step);
+		ph1 = vaddq_u32(ph1, step);
+		phase += incr * 8;
+	}
+	interpolate_tail<ENVELOPE>(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+}
+
+// The exact-ratio copy for steps of one and two samples; see copy_sse2().
+static void copy_neon(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	const int32x4_t vamp = vdupq_n_s32(amp);
+	const int16x8_t vbias = vdupq_n_s16(bias);
+	const uint32_t env_start[4] = { env_mult + (uint32_t)env_incr, env_mult + (uint32_t)env_incr * 2,
+		env_mult + (uint32_t)env_incr * 3, env_mult + (uint32_t)env_incr * 4 };
+	const int32x4_t env_step = vdupq_n_s32((uint32_t)env_incr * 8);
+	const int32x4_t gain_mask = vdupq_n_s32(0xFFFF);
+	int32x4_t env0 = vreinterpretq_s32_u32(vld1q_u32(env_start));
+	int32x4_t env1 = vaddq_s32(env0, vdupq_n_s32((uint32_t)env_incr * 4));
+
+	if (step == 1 || step == 2) {
+		const int reserve = step == 2;
+		for (; count >= 8 + reserve; count -= 8, out += 8, index += 8 * step) {
+			// vld2q_s16() de-interleaves, so val[0] holds the even samples
+			int16x8_t x = step == 2 ? vld2q_s16(sample + index).val[0] : vld1q_s16(sample + index);
+			x = vsubq_s16(x, vandq_s16(vreinterpretq_s16_u16(vcgtq_s16(x, vdupq_n_s16(0))), vbias));
+			int16x4_t r0 = vmovn_s32(vshrq_n_s32(vmulq_s32(vamp, vmovl_s16(vget_low_s16(x))), 16));
+			int16x4_t r1 = vmovn_s32(vshrq_n_s32(vmulq_s32(vamp, vmovl_s16(vget_high_s16(x))), 16));
+			int32x4_t gain0 = vshrq_n_s32(env0, 15), gain1 = vshrq_n_s32(env1, 15);
+			int32x4_t x0 = vmovl_s16(r0), x1 = vmovl_s16(r1);
+			r0 = vmovn_s32(vaddq_s32(vmulq_s32(vshrq_n_s32(gain0, 16), x0),
+				vshrq_n_s32(vmulq_s32(vandq_s32(gain0, gain_mask), x0), 16)));
+			r1 = vmovn_s32(vaddq_s32(vmulq_s32(vshrq_n_s32(gain1, 16), x1),
+				vshrq_n_s32(vmulq_s32(vandq_s32(gain1, gain_mask), x1), 16)));
+			vst1q_s16(out, vcombine_s16(r0, r1));
+			env0 = vaddq_s32(env0, env_step);
+			env1 = vaddq_s32(env1, env_step);
+			env_mult += (uint32_t)env_incr * 8;
+		}
+	}
+	wavetable_copy_envelope_scalar(out, count, index, step, sample, bias, amp, env_mult, env_incr);
+}
+#endif // __ARM_NEON
+
+// Higher-order modes. For samples without guard samples every tap index is
+// checked once per output sample: the common case reads straight from the
+// sample, the first and last few indices go through sample_at(), which treats
+// everything outside the sample as 0. Guarded samples skip the check.
+
+static inline int32_t sample_at(const int16_t* sample, uint32_t length, uint32_t index)
+{
+	return index < length ? sample[index] : 0;
+}
+
+static inline int16_t saturate_interpolated(int32_t acc)
+{
+	acc = (acc + (1 << (INTERPOLATION_COEFFICIENT_BITS - 1))) >> INTERPOLATION_COEFFICIENT_BITS;
+	return acc > INT16_MAX ? INT16_MAX : acc < INT16_MIN ? INT16_MIN : acc;
+}
+
+// scales an amp-scaled sample by the next step of the envelope ramp
+template <bool ENVELOPE>
+static inline int16_t apply_envelope(int32_t& env_mult, int32_t env_incr, int32_t x)
+{
+	if (!ENVELOPE) return x;
+	env_mult += env_incr;
+	return signed_multiply_32x16b(env_mult >> 15, x);
+}
+
+// the phase never reaches the sample end, so the one tap is always in bounds
+template <bool ENVELOPE>
+static void interpolate_drop(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	for (; count; --count, ++out, phase += incr) {
+		uint32_t index = phase >> (32 - index_bits);
+		*out = apply_envelope<ENVELOPE>(env_mult, env_incr, signed_multiply_32x16b(amp, sample[index]));
+	}
+}
+
+// Runs a TAPS-tap interpolator over 'count' samples. Tap BEFORE lines up with
+// the sample at or before the phase, and the top TABLE_BITS bits of the
+// fraction select the coefficient row.
+template <int TAPS, int BEFORE, int TABLE_BITS, bool GUARDED, bool ENVELOPE>
+static void interpolate_fir(const int16_t (*table)[TAPS], int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, uint32_t length, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	const uint32_t fast_count = length >= TAPS ? length - TAPS + 1 : 0;
+	for (; count; --count, ++out, phase += incr) {
+		uint32_t first = (phase >> (32 - index_bits)) - BEFORE;
+		const int16_t* c = table[(phase << index_bits) >> (32 - TABLE_BITS)];
+		int32_t acc = 0;
+		if (GUARDED || first < fast_count) {
+			const int16_t* x = sample + (int32_t)first;
+			for (int k = 0; k < TAPS; ++k) acc += c[k] * x[k];
+		} else {
+			for (int k = 0; k < TAPS; ++k) acc += c[k] * sample_at(sample, length, first + k);
+		}
+		*out = apply_envelope<ENVELOPE>(env_mult, env_incr, signed_multiply_32x16b(amp, saturate_interpolated(acc)));
+	}
+}
+
+template <bool ENVELOPE>
+static void interpolate_table(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, uint32_t length, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	switch (mode) {
+	case INTERPOLATION_DROP:
+		interpolate_drop<ENVELOPE>(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+		break;
+	case INTERPOLATION_HERMITE:
+		if (length == WAVETABLE_GUARDED)
+			interpolate_fir<4, 1, HERMITE_TABLE_BITS, true, ENVELOPE>(hermite_table, out, count, phase, incr,
+				sample, length, index_bits, amp, env_mult, env_incr);
+		else
+			interpolate_fir<4, 1, HERMITE_TABLE_BITS, false, ENVELOPE>(hermite_table, out, count, phase, incr,
+				sample, length, index_bits, amp, env_mult, env_incr);
+		break;
+	case INTERPOLATION_SINC:
+		if (length == WAVETABLE_GUARDED)
+			interpolate_fir<SINC_TAPS, SINC_TAPS / 2 - 1, SINC_TABLE_BITS, true, ENVELOPE>(sinc_table, out, count, phase, incr,
+				sample, length, index_bits, amp, env_mult, env_incr);
+		else
+			interpolate_fir<SINC_TAPS, SINC_TAPS / 2 - 1, SINC_TABLE_BITS, false, ENVELOPE>(sinc_table, out, count, phase, incr,
+				sample, length, index_bits, amp, env_mult, env_incr);
+		break;
+	default:
+		if (ENVELOPE) wavetable_interpolate_envelope(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+		else wavetable_interpolate(out, count, phase, incr, sample, index_bits, amp);
+		break;
+	}
+}
+
+void wavetable_interpolate_table(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, uint32_t length, int index_bits, int32_t amp)
+{
+	interpolate_table<false>(mode, out, count, phase, incr, sample, length, index_bits, amp, 0, 0);
+}
+
+void wavetable_interpolate_table_envelope(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase,
+	uint32_t incr, const int16_t* sample, uint32_t length, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	interpolate_table<true>(mode, out, count, phase, incr, sample, length, index_bits, amp, env_mult, env_incr);
+}
+
+static const char* const interpolation_names[INTERPOLATION_COUNT] = { "drop", "linear", "hermite", "sinc" };
+
+const char* wavetable_interpolation_name(interpolationModeEnum mode)
+{
+	return mode < INTERPOLATION_COUNT ? interpolation_names[mode] : "unknown";
+}
+
+static const char* const kernel_names[KERNEL_COUNT] = { "scalar", "sse2", "avx2", "neon" };
+
+bool wavetable_kernel_supported(wavetableKernelEnum kernel)
+{
+	switch (kernel) {
+	case KERNEL_SCALAR:
+		return true;
+#if defined(__SSE2__)
+	case KERNEL_SSE2:
+		return true;
+	case KERNEL_AVX2:
+		return __builtin_cpu_supports("avx2");
+#endif
+#if defined(__ARM_NEON)
+	case KERNEL_NEON:
+		return true;
+#endif
+	default:
+		return false;
+	}
+}
+
+#if defined(WAVETABLE_SIMD)
+static wavetableKernelEnum selected_kernel = KERNEL_SCALAR;
+
+// the kernels without the envelope ignore its (zero) arguments
+template <void (*KERNEL)(int16_t*, int, uint32_t, uint32_t, const int16_t*, int, int32_t, int32_t, int32_t)>
+static void without_envelope(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp)
+{
+	KERNEL(out, count, phase, incr, sample, index_bits, amp, 0, 0);
+}
+
+static wavetable_interpolate_fn kernel_function(wavetableKernelEnum kernel)
+{
+	switch (kernel) {
+#if defined(__SSE2__)
+	case KERNEL_SSE2: return without_envelope<interpolate_sse2<false> >;
+	case KERNEL_AVX2: return without_envelope<interpolate_avx2<false> >;
+#endif
+#if defined(__ARM_NEON)
+	case KERNEL_NEON: return without_envelope<interpolate_neon<false> >;
+#endif
+	default: return interpolate_scalar;
+	}
+}
+
+static wavetable_interpolate_envelope_fn envelope_kernel_function(wavetableKernelEnum kernel)
+{
+	switch (kernel) {
+#if defined(__SSE2__)
+	case KERNEL_SSE2: return interpolate_sse2<true>;
+	case KERNEL_AVX2: return interpolate_avx2<true>;
+#endif
+#if defined(__ARM_NEON)
+	case KERNEL_NEON: return interpolate_neon<true>;
+#endif
+	default: return interpolate_envelope_scalar;
+	}
+}
+
+static void copy_envelope_scalar(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	wavetable_copy_envelope_scalar(out, count, index, step, sample, bias, amp, env_mult, env_incr);
+}
+
+static wavetable_copy_envelope_fn copy_kernel_function(wavetableKernelEnum kernel)
+{
+	switch (kernel) {
+#if defined(__SSE2__)
+	case KERNEL_SSE2: return copy_sse2;
+	case KERNEL_AVX2: return copy_avx2;
+#endif
+#if defined(__ARM_NEON)
+	case KERNEL_NEON: return copy_neon;
+#endif
+	default: return copy_envelope_scalar;
+	}
+}
+
+static wavetable_interpolate_fn select_best_kernel(void)
+{
+	for (int k = KERNEL_COUNT - 1; k > KERNEL_SCALAR; --k) {
+		if (wavetable_kernel_supported((wavetableKernelEnum)k)) {
+			selected_kernel = (wavetableKernelEnum)k;
+			break;
+		}
+	}
+	return kernel_function(selected_kernel);
+}
+
+wavetable_interpolate_fn wavetable_interpolate_kernel = select_best_kernel();
+wavetable_interpolate_envelope_fn wavetable_interpolate_envelope_kernel = envelope_kernel_function(selected_kernel);
+wavetable_copy_envelope_fn wavetable_copy_envelope_kernel = copy_kernel_function(selected_kernel);
+
+bool wavetable_select_kernel(wavetableKernelEnum kernel)
+{
+	if (!wavetable_kernel_supported(kernel)) return false;
+	selected_kernel = kernel;
+	wavetable_interpolate_kernel = kernel_function(kernel);
+	wavetable_interpolate_envelope_kernel = envelope_kernel_function(kernel);
+	wavetable_copy_envelope_kernel = copy_kernel_function(kernel);
+	return true;
+}
+
+wavetableKernelEnum wavetable_selected_kernel(void)
+{
+	return selected_kernel;
+}
+#else
+bool wavetable_select_kernel(wavetableKernelEnum kernel)
+{
+	return kernel == KERNEL_SCALAR;
+}
+
+wavetableKernelEnum wavetable_selected_kernel(void)
+{
+	return KERNEL_SCALAR;
+}
+#endif // WAVETABLE_SIMD
+
+const char* wavetable_kernel_name(wavetableKernelEnum kernel)
+{
+	return kernel < KERNEL_COUNT ? kernel_names[kernel] : "unknown";
+}
@@ -0,0 +1,252 @@
+/* Audio Library for Teensy 3.X
+ * Copyright (c) 2017, TeensyAudio PSU Team
+ *
+ * Development of this audio library was sponsored by PJRC.COM, LLC.
+ * Please support PJRC's efforts to develop open source 
+ * software by purchasing Teensy or other PJRC products.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice, development funding notice, and this permission
+ * notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <dspinst.h>
+
+// Inner-loop kernels for AudioSynthWavetable.
+//
+// wavetable_interpolate() renders 'count' output samples by linear
+// interpolation between adjacent 16-bit PCM values, starting at 'phase' and
+// stepping by 'incr', then scales them by 'amp'. It never wraps or stops the
+// phase, so callers must only pass spans in which the phase stays below the
+// sample's loop end (or end, for one-shots).
+//
+// wavetable_interpolate_envelope() does the same and also applies the
+// voice's envelope ramp before storing each sample, so render() makes a
+// single pass over the block.
+//
+// wavetable_copy_envelope() is the exact-ratio path: when the phase and
+// 'incr' are whole numbers of samples the fraction is always zero, so the
+// output is a copy (or decimation) of the sample with only the gain applied.
+//
+// On the Teensy this is always the scalar kernel built from the dspinst.h
+// helpers. On hosts with SSE2/AVX2 or NEON a vector kernel is selected at
+// startup; every kernel produces bit-identical output to the scalar one.
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define WAVETABLE_SIMD
+#endif
+
+enum wavetableKernelEnum { KERNEL_SCALAR, KERNEL_SSE2, KERNEL_AVX2, KERNEL_NEON, KERNEL_COUNT };
+
+typedef void (*wavetable_interpolate_fn)(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp);
+
+// reads sample[0] into the low and sample[1] into the high halfword
+static inline uint32_t load_sample_pair(const int16_t* sample) __attribute__((always_inline, unused));
+static inline uint32_t load_sample_pair(const int16_t* sample)
+{
+#if defined(KINETISK)
+	return *((uint32_t*)sample);
+#else
+	uint32_t pair;
+	memcpy(&pair, sample, sizeof(pair));
+	return pair;
+#endif
+}
+
+static inline void wavetable_interpolate_scalar(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp) __attribute__((always_inline, unused));
+static inline void wavetable_interpolate_scalar(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp)
+{
+	for (; count; --count, ++out) {
+		uint32_t index = phase >> (32 - index_bits);
+		uint32_t tmp = load_sample_pair(sample + index);
+		uint32_t scale = (phase << index_bits) >> 16;
+		int32_t s = signed_multiply_32x16t(scale, tmp);
+		s = signed_multiply_accumulate_32x16b(s, 0xFFFF - scale, tmp);
+		*out = signed_multiply_32x16b(amp, s);
+		phase += incr;
+	}
+}
+
+// As wavetable_interpolate_scalar(), then applies an envelope ramp to each
+// sample before it is stored: the envelope gain steps by 'env_incr' before
+// every sample, starting from 'env_mult', and multiplies the sample the way
+// AudioSynthWavetable always has, signed_multiply_32x16b(env_mult >> 15, x).
+static inline void wavetable_interpolate_envelope_scalar(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr) __attribute__((always_inline, unused));
+static inline void wavetable_interpolate_envelope_scalar(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	for (; count; --count, ++out) {
+		uint32_t index = phase >> (32 - index_bits);
+		uint32_t tmp = load_sample_pair(sample + index);
+		uint32_t scale = (phase << index_bits) >> 16;
+		int32_t s = signed_multiply_32x16t(scale, tmp);
+		s = signed_multiply_accumulate_32x16b(s, 0xFFFF - scale, tmp);
+		env_mult += env_incr;
+		*out = signed_multiply_32x16b(env_mult >> 15, signed_multiply_32x16b(amp, s));
+		phase += incr;
+	}
+}
+
+typedef void (*wavetable_interpolate_envelope_fn)(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr);
+
+// Renders 'count' samples reading every 'step'th sample from 'index' on,
+// scaled by 'amp' and the envelope ramp as in
+// wavetable_interpolate_envelope_scalar(). With a zero fraction linear
+// interpolation yields (0xFFFF * x) >> 16, one less than x for positive x,
+// and the other modes yield x; 'bias' is that 1 for linear and 0 otherwise,
+// so the output is bit-identical to interpolating.
+static inline void wavetable_copy_envelope_scalar(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr) __attribute__((always_inline, unused));
+static inline void wavetable_copy_envelope_scalar(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+	for (; count; --count, ++out, index += step) {
+		int32_t x = sample[index];
+		if (x > 0) x -= bias;
+		env_mult += env_incr;
+		*out = signed_multiply_32x16b(env_mult >> 15, signed_multiply_32x16b(amp, x));
+	}
+}
+
+typedef void (*wavetable_copy_envelope_fn)(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr);
+
+#ifdef WAVETABLE_SIMD
+extern wavetable_interpolate_fn wavetable_interpolate_kernel;
+extern wavetable_interpolate_envelope_fn wavetable_interpolate_envelope_kernel;
+extern wavetable_copy_envelope_fn wavetable_copy_envelope_kernel;
+#endif
+
+static inline void wavetable_interpolate(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp) __attribute__((always_inline, unused));
+static inline void wavetable_interpolate(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp)
+{
+#ifdef WAVETABLE_SIMD
+	wavetable_interpolate_kernel(out, count, phase, incr, sample, index_bits, amp);
+#else
+	wavetable_interpolate_scalar(out, count, phase, incr, sample, index_bits, amp);
+#endif
+}
+
+static inline void wavetable_interpolate_envelope(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr) __attribute__((always_inline, unused));
+static inline void wavetable_interpolate_envelope(int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+#ifdef WAVETABLE_SIMD
+	wavetable_interpolate_envelope_kernel(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+#else
+	wavetable_interpolate_envelope_scalar(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+#endif
+}
+
+static inline void wavetable_copy_envelope(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr) __attribute__((always_inline, unused));
+static inline void wavetable_copy_envelope(int16_t* out, int count, uint32_t index, uint32_t step,
+	const int16_t* sample, int32_t bias, int32_t amp, int32_t env_mult, int32_t env_incr)
+{
+#ifdef WAVETABLE_SIMD
+	wavetable_copy_envelope_kernel(out, count, index, step, sample, bias, amp, env_mult, env_incr);
+#else
+	wavetable_copy_envelope_scalar(out, count, index, step, sample, bias, amp, env_mult, env_incr);
+#endif
+}
+
+// True if every phase from 'phase' on in steps of 'incr' falls on a whole
+// sample, so wavetable_copy_envelope() can stand in for interpolation.
+static inline bool wavetable_exact_ratio(uint32_t phase, uint32_t incr, int index_bits) __attribute__((always_inline, unused));
+static inline bool wavetable_exact_ratio(uint32_t phase, uint32_t incr, int index_bits)
+{
+	return ((phase | incr) << index_bits) == 0;
+}
+
+// Kernel selection. The fastest supported kernel is selected at startup;
+// tests and benchmarks can force another one.
+bool wavetable_kernel_supported(wavetableKernelEnum kernel);
+bool wavetable_select_kernel(wavetableKernelEnum kernel);
+wavetableKernelEnum wavetable_selected_kernel(void);
+const char* wavetable_kernel_name(wavetableKernelEnum kernel);
+
+// Interpolation modes, cheapest first:
+//  - INTERPOLATION_DROP reads the sample at or before the phase;
+//  - INTERPOLATION_LINEAR is the 2-point linear kernel above (the default);
+//  - INTERPOLATION_HERMITE is 4-point, 3rd-order Hermite (Catmull-Rom);
+//  - INTERPOLATION_SINC is an 8-tap Kaiser-windowed sinc.
+// The Hermite and sinc weights come from Q14 tables indexed by the top bits
+// of the phase fraction, generated by interpolation_tables.py. Taps that fall
+// outside the sample's 'length' read as silence, unless 'length' is
+// WAVETABLE_GUARDED: then the sample carries guard samples and every tap is
+// read without a bounds check.
+enum interpolationModeEnum { INTERPOLATION_DROP, INTERPOLATION_LINEAR, INTERPOLATION_HERMITE, INTERPOLATION_SINC, INTERPOLATION_COUNT };
+
+#define INTERPOLATION_COEFFICIENT_BITS 14
+#define HERMITE_TABLE_BITS 8
+#define SINC_TABLE_BITS 9
+#define SINC_TAPS 8
+
+// Decoder output pads each sample (and mip level) with this many samples
+// before its start and after its loop end (a copy of the loop start) or end
+// (silence), enough for the widest interpolator.
+#define WAVETABLE_GUARD_SAMPLES 4
+#define WAVETABLE_GUARDED UINT32_MAX
+
+#if WAVETABLE_GUARD_SAMPLES < SINC_TAPS / 2
+#error "guard samples must cover half the sinc taps"
+#endif
+
+extern const int16_t hermite_table[1 << HERMITE_TABLE_BITS][4];
+extern const int16_t sinc_table[1 << SINC_TABLE_BITS][SINC_TAPS];
+
+void wavetable_interpolate_table(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase, uint32_t incr,
+	const int16_t* sample, uint32_t length, int index_bits, int32_t amp);
+
+static inline void wavetable_interpolate_mode(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase,
+	uint32_t incr, const int16_t* sample, uint32_t length, int index_bits, int32_t amp) __attribute__((always_inline, unused));
+static inline void wavetable_interpolate_mode(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase,
+	uint32_t incr, const int16_t* sample, uint32_t length, int index_bits, int32_t amp)
+{
+	if (mode == INTERPOLATION_LINEAR) wavetable_interpolate(out, count, phase, incr, sample, index_bits, amp);
+	else wavetable_interpolate_table(mode, out, count, phase, incr, sample, length, index_bits, amp);
+}
+
+void wavetable_interpolate_table_envelope(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase,
+	uint32_t incr, const int16_t* sample, uint32_t length, int index_bits, int32_t amp, int32_t env_mult, int32_t env_incr);
+
+// The fused form AudioSynthWavetable::render() uses: interpolation in 'mode'
+// and the envelope ramp in a single pass over 'out'.
+static inline void wavetable_interpolate_mode_envelope(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase,
+	uint32_t incr, const int16_t* sample, uint32_t length, int index_bits, int32_t amp, int32_t env_mult,
+	int32_t env_incr) __attribute__((always_inline, unused));
+static inline void wavetable_interpolate_mode_envelope(interpolationModeEnum mode, int16_t* out, int count, uint32_t phase,
+	uint32_t incr, const int16_t* sample, uint32_t length, int index_bits, int32_t amp, int32_t env_mult,
+	int32_t env_incr)
+{
+	if (mode == INTERPOLATION_LINEAR) wavetable_interpolate_envelope(out, count, phase, incr, sample, index_bits, amp, env_mult, env_incr);
+	else wavetable_interpolate_table_envelope(mode, out, count, phase, incr, sample, length, index_bits, amp, env_mult, env_incr);
+}
+
+const char* wavetable_interpolation_name(interpolationModeEnum mode);